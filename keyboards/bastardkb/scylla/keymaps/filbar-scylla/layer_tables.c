@@ -0,0 +1,51 @@
+// Generated by tools/gen_layers.py from layouts/filbar/layers.json, do not edit.
+#include "layer_tables.h"
+
+// clang-format off
+const layer_table_t layer_table_bound[MATRIX_ROWS][MATRIX_COLS] = LAYOUT_split_4x6_5(
+    0xE9, 0xF9, 0xF9, 0xF9, 0xF9, 0xF9,     0xF9, 0xF9, 0xF9, 0xF9, 0xF9, 0xF1,
+    0xE9, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,     0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xC9, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,     0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xC1, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,     0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                      0x81, 0x81, 0x91,     0xA9, 0x81, 0x81,
+                            0x81, 0x81,     0x81, 0x81
+);
+
+const layer_table_t layer_table_tap_hold[MATRIX_ROWS][MATRIX_COLS] = LAYOUT_split_4x6_5(
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x01,     0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00,     0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00,     0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00,     0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                      0x00, 0x01, 0x00,     0x00, 0x00, 0x00,
+                            0x00, 0x00,     0x00, 0x00
+);
+
+const uint8_t layer_table_keys[MATRIX_ROWS][MATRIX_COLS] = LAYOUT_split_4x6_5(
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01,     0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01,     0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01,     0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01,     0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+                      0x05, 0x05, 0x05,     0x06, 0x06, 0x06,
+                            0x05, 0x05,     0x06, 0x06
+);
+
+const uint8_t layer_table_slots[MATRIX_ROWS][MATRIX_COLS] = LAYOUT_split_4x6_5(
+    1,  2,  3,  4,  5,  6,      7,  8,  9,  10, 11, 12,
+    13, 14, 15, 16, 17, 18,     19, 20, 21, 22, 23, 24,
+    25, 26, 27, 28, 29, 30,     31, 32, 33, 34, 35, 36,
+    37, 38, 39, 40, 41, 42,     43, 44, 45, 46, 47, 48,
+                49, 50, 51,     52, 53, 54,
+                    55, 56,     57, 58
+);
+// clang-format on
+
+const HSV layer_table_colours[LAYER_TABLE_COUNT] = {
+    [0] = {HSV_OFF},     // _BASE
+    [1] = {HSV_GREEN},   // _COLEMAK
+    [2] = {HSV_RED},     // _QWERTY
+    [3] = {HSV_WHITE},   // _SYM
+    [4] = {HSV_AZURE},   // _NAV
+    [5] = {HSV_PURPLE},  // _RAISE
+    [6] = {HSV_RED},     // _CONF
+    [7] = {HSV_GOLD},    // _STENO
+};
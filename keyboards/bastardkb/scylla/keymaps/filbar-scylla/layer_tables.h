@@ -0,0 +1,51 @@
+// Generated by tools/gen_layers.py from layouts/filbar/layers.json, do not edit.
+//
+// Constant per-key tables for the scylla layers, in matrix order like
+// keymaps[].  A layer_table_t holds one bit per layer, bit n for layer n.
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+#define LAYER_TABLE_COUNT 8
+
+// Layers text is typed on, the base layer and the default layers
+#define LAYER_TABLE_TYPING 0x07
+
+typedef uint8_t layer_table_t;
+
+// layer_table_keys flags, 0 where the matrix has no key
+#define LAYER_TABLE_KEY_LEFT 0x01
+#define LAYER_TABLE_KEY_RIGHT 0x02
+#define LAYER_TABLE_KEY_THUMB 0x04
+
+// Layers the key is bound on, anything but KC_TRNS
+extern const layer_table_t layer_table_bound[MATRIX_ROWS][MATRIX_COLS];
+
+// Layers the key is a mod-tap or layer-tap on
+extern const layer_table_t layer_table_tap_hold[MATRIX_ROWS][MATRIX_COLS];
+
+// Hand and cluster of the key
+extern const uint8_t layer_table_keys[MATRIX_ROWS][MATRIX_COLS];
+
+// Indicator colour of each layer
+extern const HSV layer_table_colours[LAYER_TABLE_COUNT];
+
+// Keys in the layout and the words of a layer_sparse_t bitmap
+#define LAYER_TABLE_KEYS 58
+#define LAYER_TABLE_WORDS 2
+
+// Position of the key in the layout plus one, 0 where the matrix has no key
+extern const uint8_t layer_table_slots[MATRIX_ROWS][MATRIX_COLS];
+
+// One layer of the sparse keymap: bit n of present is set when layout key n
+// is stored, in layer_sparse_keycodes from offset[n / 32] on, and clear when
+// it is fill
+typedef struct {
+    uint32_t present[LAYER_TABLE_WORDS];
+    uint16_t offset[LAYER_TABLE_WORDS];
+    uint16_t fill;
+} layer_sparse_t;
+
+// Both in keymap.c, next to keymaps[]
+extern const uint16_t       layer_sparse_keycodes[];
+extern const layer_sparse_t layer_sparse[LAYER_TABLE_COUNT];
@@ -16,5 +16,16 @@ CAPS_WORD_ENABLE = yes
 AUTO_SHIFT_ENABLE = yes
 DYNAMIC_TAPPING_TERM_ENABLE = yes
 
-SRC += features/layer_lock.c
-SRC += features/swapper.c
+# Shared features and their switches live in users/filbar/rules.mk, turn
+# the optional ones on here
+USER_NAME := filbar
+LEADER_TRIE_ENABLE = yes
+POSITION_COMBO_ENABLE = yes
+TEXT_EXPAND_ENABLE = yes
+MACRO_RECORDER_ENABLE = yes
+STENO_CHORD_ENABLE = yes
+
+# Generated with the keymap, see tools/gen_layers.py
+SRC += layer_tables.c
+
+SRC += features/layer_fade.c
@@ -27,6 +27,24 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define AUTO_SHIFT_TIMEOUT 235
 #define RETRO_SHIFT 500  /* Anything held for more than this will not be shifted */
 
+/* Lets the slave half know when the last key was pressed, for the idle governor */
+#define SPLIT_ACTIVITY_ENABLE
+
+/* The slave half's keymap cache and OLED legends follow the active layer */
+#define SPLIT_LAYER_STATE_ENABLE
+
+/* Userspace state for the slave half, see features/split_sync.h */
+#ifdef SPLIT_STATS_ENABLE
+#    define SPLIT_TRANSACTION_IDS_USER USER_SYNC_STATE, USER_LINK_BENCH
+#else
+#    define SPLIT_TRANSACTION_IDS_USER USER_SYNC_STATE
+#endif
+
+/* Recorded macros survive a power cycle, MACRO_RECORDER_STORE_SIZE bytes
+ * of the EECONFIG user datablock (see features/macro_recorder.h) */
+#define MACRO_RECORDER_PERSIST
+#define EECONFIG_USER_DATA_SIZE 520
+
 
 /* RGB Modes */
 #define ENABLE_RGB_MATRIX_NONE
@@ -53,7 +71,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define ENABLE_RGB_MATRIX_HUE_PENDULUM
 #define ENABLE_RGB_MATRIX_HUE_WAVE
 #define ENABLE_RGB_MATRIX_PIXEL_FRACTAL
-#define ENABLE_RGB_MATRIX_TYPING_HEATMAP
+// Typing heatmap is the filbar_heatmap effect in rgb_matrix_user.inc
 #define ENABLE_RGB_MATRIX_DIGITAL_RAIN
 #define ENABLE_RGB_MATRIX_SOLID_REACTIVE_SIMPLE
 #define ENABLE_RGB_MATRIX_SOLID_REACTIVE
@@ -70,5 +88,15 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define ENABLE_RGB_MATRIX_RIVERFLOW
 #define ENABLE_RGB_MATRIX_EFFECT_MAX
 
+/* Render at most an eighth of the LEDs per scan */
+#define RGB_MATRIX_LED_PROCESS_LIMIT ((RGB_MATRIX_LED_COUNT + 7) / 8)
+
+/* Frame interval is picked at runtime by features/rgb_governor.c */
+#ifndef __ASSEMBLER__
+#    include <stdint.h>
+extern uint32_t rgb_governor_flush_limit;
+#endif
+#define RGB_MATRIX_LED_FLUSH_LIMIT rgb_governor_flush_limit
+
 
 
@@ -10,6 +10,28 @@
 #include QMK_KEYBOARD_H
 #include "features/layer_lock.h"
 #include "features/swapper.h"
+#include "features/profiler.h"
+#include "features/scan_monitor.h"
+#include "features/host_hook.h"
+#include "features/key_latency.h"
+#include "features/mem_stats.h"
+#include "features/boot_profile.h"
+#include "features/deferred_init.h"
+#include "features/idle.h"
+#include "features/rgb_governor.h"
+#include "features/keymap_cache.h"
+#include "features/split_sync.h"
+#include "features/split_stats.h"
+#include "features/heatmap.h"
+#include "features/key_trace.h"
+#include "features/leader_trie.h"
+#include "features/text_expand.h"
+#include "features/position_combo.h"
+#include "features/macro_recorder.h"
+#include "features/steno_chord.h"
+#include "features/oneshot.h"
+#include "features/oled_legend.h"
+#include "layer_tables.h"
 
 #ifdef CONSOLE_ENABLE
 #   include "print.h"
@@ -17,7 +39,8 @@
 
 extern keymap_config_t keymap_config;
 
-enum lily_layers {
+// BEGIN GENERATED layers, edit layouts/filbar/layers.json and run tools/gen_layers.py
+enum filbar_layers {
     _BASE = 0,
     _COLEMAK,
     _QWERTY,
@@ -25,20 +48,30 @@ enum lily_layers {
     _NAV,
     _RAISE,
     _CONF,
+    _STENO,
 };
 
 #define DEFAULT_LAYER _COLEMAK
 
-enum lily_keycodes {
+enum filbar_keycodes {
     LLOCK = SAFE_RANGE,
-    SW_APP,  // Switch app windows (cmd-tab)
-    SW_WIN   // Switch apps        (cmd-`)
+    SW_APP,   // Switch app windows (cmd-tab)
+    SW_WIN,   // Switch apps        (cmd-`)
+    STATS,    // Dump profiling stats to the console, shifted runs the split link benchmark
+    LDR,      // Start a leader sequence, see features/leader_trie.h
+    MREC,     // Record a macro into the next MACn slot, see features/macro_recorder.h
+    MAC1,     // Play a macro slot, shifted at the speed it was recorded
+    MAC2,
+    MAC3,
+    STENO,    // Lock the steno layer on or off, see features/steno_chord.h
+    ST_UP,    // Send steno chords when the first key is released, not the last
+    OS_SHFT,  // One-shot modifiers, see features/oneshot.h
+    OS_CTRL,
+    OS_ALT,
+    OS_CMD
 };
 
-
-/*
- * Custom key definitions
- */
+// Custom key definitions
 #define WEBTAB_L G(KC_LCBR)
 #define WEBTAB_R G(KC_RCBR)
 #define LN_END G(KC_RIGHT)
@@ -46,206 +79,266 @@ enum lily_keycodes {
 #define WORD_R A(KC_RIGHT)
 #define WORD_L A(KC_LEFT)
 #define LOGOUT G(C(KC_Q))
-
 #define QWERTY DF(_QWERTY)
 #define COLEMK DF(_COLEMAK)
 #define CLEAR QK_CLEAR_EEPROM
+// END GENERATED layers
 
-// Left-hand home row mods for Colemak
-#define CMH_Z LGUI_T(KC_Z)
-#define CMH_X LALT_T(KC_X)
-#define CMH_C LSFT_T(KC_C)
-#define CMH_D LCTL_T(KC_D)
-
-// Right-hand home row mods for Colemak
-#define CMH_SLSH RGUI_T(KC_SLSH)
-#define CMH_DOT LALT_T(KC_DOT)
-#define CMH_COMM RSFT_T(KC_COMM)
-#define CMH_H RCTL_T(KC_H)
-
-// Left-hand home row mods for Qwerty
-#define QMH_Z LGUI_T(KC_Z)
-#define QMH_X LALT_T(KC_X)
-#define QMH_C LSFT_T(KC_C)
-#define QMH_V LCTL_T(KC_V)
-
-// Right-hand home row mods for Qwerty
-#define QMH_M LALT_T(KC_M)
-#define QMH_N RSFT_T(KC_N)
-#define QMH_COMM RCTL_T(KC_COMM)
-#define QMH_DOT RGUI_T(KC_DOT)
-
-
-
+// BEGIN GENERATED keymaps, edit layouts/filbar/layers.json and run tools/gen_layers.py
 // clang-format off
 const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
+    [_BASE] = LAYOUT(
+        QK_GESC, KC_1,    KC_2,    KC_3,    KC_4,    LT(_CONF,KC_5),                               KC_6,       KC_7,    KC_8,    KC_9,    KC_0,    KC_BSPC,
+        KC_TAB,  XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,                                      XXXXXXX,    XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,
+        KC_LSFT, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,                                      XXXXXXX,    XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,
+        KC_LGUI, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,        KC_BSPC,             KC_LSFT, XXXXXXX,    XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,
+                                   KC_LCTL, KC_LGUI, MO(_NAV),       LT(_SYM,KC_SPC),     KC_ENT,  MO(_RAISE), KC_RALT, KC_LGUI
+    ),
+
+    [_COLEMAK] = LAYOUT(
+        _______, _______, _______, _______, _______, _______,                       _______, _______, _______, _______, _______, _______,
+        _______, KC_Q,    KC_W,    KC_F,    KC_P,    KC_B,                          KC_J,    KC_L,    KC_U,    KC_Y,    KC_SCLN, KC_MINS,
+        _______, KC_A,    KC_R,    KC_S,    KC_T,    KC_G,                          KC_M,    KC_N,    KC_E,    KC_I,    KC_O,    KC_QUOT,
+        _______, KC_Z,    KC_X,    KC_C,    KC_D,    KC_V,    _______,     _______, KC_K,    KC_H,    KC_COMM, KC_DOT,  KC_SLSH, KC_BSLS,
+                                   _______, _______, _______, _______,     _______, _______, _______, _______
+    ),
+
+    [_QWERTY] = LAYOUT(
+        _______, _______, _______, _______, _______, _______,                       _______, _______, _______, _______, _______, _______,
+        _______, KC_Q,    KC_W,    KC_E,    KC_R,    KC_T,                          KC_Y,    KC_U,    KC_I,    KC_O,    KC_P,    KC_MINS,
+        _______, KC_A,    KC_S,    KC_D,    KC_F,    KC_G,                          KC_H,    KC_J,    KC_K,    KC_L,    KC_SCLN, KC_QUOT,
+        _______, KC_Z,    KC_X,    KC_C,    KC_V,    KC_B,    _______,     _______, KC_N,    KC_M,    KC_COMM, KC_DOT,  KC_SLSH, KC_BSLS,
+                                   _______, _______, _______, _______,     _______, _______, _______, _______
+    ),
+
+    [_SYM] = LAYOUT(
+        SW_WIN,  XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, LOGOUT,                        XXXXXXX, KC_NO,   KC_NO,  KC_NO, KC_SLSH, _______,
+        SW_APP,  KC_LT,   KC_LBRC, KC_RBRC, KC_GT,   XXXXXXX,                       KC_NO,   KC_7,    KC_8,   KC_9,  KC_ASTR, KC_MINUS,
+        CW_TOGG, KC_LCBR, KC_LPRN, KC_RPRN, KC_RCBR, XXXXXXX,                       KC_DOT,  KC_4,    KC_5,   KC_6,  KC_PLUS, KC_EQL,
+        _______, OS_CMD,  OS_ALT,  OS_SHFT, OS_CTRL, XXXXXXX, _______,     LLOCK,   KC_NO,   KC_1,    KC_2,   KC_3,  KC_0,    KC_UNDS,
+                                   _______, _______, _______, _______,     _______, _______, _______, _______
+    ),
+
+    [_NAV] = LAYOUT(
+        _______, MREC,    MAC1,    MAC2,    MAC3,    KC_BTN3,                       KC_PGUP, KC_MRWD,  KC_MPLY, KC_MFFD,  KC_VOLU, _______,
+        _______, KC_BTN2, KC_WH_L, KC_MS_U, KC_WH_R, KC_BTN1,                       KC_PGDN, WEBTAB_L, KC_UP,   WEBTAB_R, KC_VOLD, XXXXXXX,
+        _______, LDR,     KC_MS_L, KC_MS_D, KC_MS_R, KC_WH_U,                       XXXXXXX, KC_LEFT,  KC_DOWN, KC_RGHT,  XXXXXXX, XXXXXXX,
+        _______, OS_CMD,  OS_ALT,  OS_SHFT, OS_CTRL, KC_WH_D, _______,     LLOCK,   LN_BEG,  WORD_L,   XXXXXXX, WORD_R,   LN_END,  XXXXXXX,
+                                   _______, _______, _______, _______,     _______, _______, _______,  _______
+    ),
+
+    [_RAISE] = LAYOUT(
+        KC_TILD, KC_F1,   KC_F2,   KC_F3,   KC_F4,   KC_F5,                         KC_F6,   KC_F7,   KC_F8,   KC_F9,   KC_F10,  LOGOUT,
+        KC_GRV,  KC_EXLM, KC_AT,   KC_HASH, KC_DLR,  KC_PERC,                       KC_CIRC, KC_AMPR, KC_ASTR, KC_LPRN, KC_RPRN, XXXXXXX,
+        _______, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,                       XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,
+        _______, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, _______,     LOGOUT,  XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,
+                                   _______, _______, _______, _______,     _______, _______, _______, _______
+    ),
+
+    [_CONF] = LAYOUT(
+        XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,                       CLEAR,   STATS,    XXXXXXX, XXXXXXX, AS_UP,   DT_UP,
+        XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,                       RGB_TOG, RGB_MOD,  RGB_HUI, XXXXXXX, AS_DOWN, DT_DOWN,
+        XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,                       XXXXXXX, RGB_RMOD, RGB_HUD, XXXXXXX, AS_RPT,  DT_PRNT,
+        XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, _______,     _______, STENO,   XXXXXXX,  XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,
+                                   _______, _______, _______, _______,     _______, QWERTY,  COLEMK,   _______
+    ),
+
+    [_STENO] = LAYOUT(
+        STN_N1,  STN_N2,  STN_N3,  STN_N4,  STN_N5,  STN_N6,                        STN_N7,  STN_N8,  STN_N9,  STN_NA,          STN_NB,        STN_NC,
+        STN_FN,  STN_S1,  STN_TL,  STN_PL,  STN_HL,  STN_ST1,                       STN_ST3, STN_FR,  STN_PR,  STN_LR,          STN_TR,        STN_DR,
+        STN_PWR, STN_S2,  STN_KL,  STN_WL,  STN_RL,  STN_ST2,                       STN_ST4, STN_RR,  STN_BR,  STN_GR,          STN_SR,        STN_ZR,
+        STENO,   XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,     XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, QK_STENO_GEMINI, QK_STENO_BOLT, ST_UP,
+                                   XXXXXXX, XXXXXXX, STN_A,   STN_O,       STN_E,   STN_U,   XXXXXXX, XXXXXXX
+    ),
+};
+// clang-format on
 
-/* BASE_MODIFIER
- * ,-----------------------------------------.                    ,-----------------------------------------.
- * | ESC  |   1  |   2  |   3  |   4  |   5  |                    |   6  |   7  |   8  |   9  |   0  | BcSp |
- * |------+------+------+------+------+------|                    |------+------+------+------+------+------|
- * | Tab  |      |      |      |      |      |                    |      |      |      |      |      |      |
- * |------+------+------+------+------+------|                    |------+------+------+------+------+------|
- * | Shft |      |      |      |      |      |-------.    ,-------|      |      |      |      |      |      |
- * |------+------+------+------+------+------| BcSp  |    | Shft  |------+------+------+------+------+------|
- * | CMD  |      |      |      |      |      |-------|    |-------|      |      |      |      |      |      |
- * `-----------------------------------------/ (SYM) /     \      \-----------------------------------------'
- *                   |      |      |      | / Space /       \ Entr \  |      |      |      |
- *                   | LCtl | CMD  |  NAV |/       /         \      \ | RAISE| RAlt | LGUI |
- *                   `----------------------------'           '------''--------------------'
- */
+// Sparse copy of keymaps[] for features/sparse_keymap.c, 283 of 464 keys
+// clang-format off
+const uint16_t PROGMEM layer_sparse_keycodes[] = {
+    // _BASE, 25 keys
+    QK_GESC, KC_1, KC_2, KC_3, KC_4, LT(_CONF,KC_5), KC_6, KC_7,
+    KC_8, KC_9, KC_0, KC_BSPC, KC_TAB, KC_LSFT, KC_LGUI, KC_BSPC,
+    KC_LSFT, KC_LCTL, KC_LGUI, MO(_NAV), LT(_SYM,KC_SPC), KC_ENT, MO(_RAISE), KC_RALT,
+    KC_LGUI,
+    // _COLEMAK, 33 keys
+    KC_Q, KC_W, KC_F, KC_P, KC_B, KC_J, KC_L, KC_U,
+    KC_Y, KC_SCLN, KC_MINS, KC_A, KC_R, KC_S, KC_T, KC_G,
+    KC_M, KC_N, KC_E, KC_I, KC_O, KC_QUOT, KC_Z, KC_X,
+    KC_C, KC_D, KC_V, KC_K, KC_H, KC_COMM, KC_DOT, KC_SLSH,
+    KC_BSLS,
+    // _QWERTY, 33 keys
+    KC_Q, KC_W, KC_E, KC_R, KC_T, KC_Y, KC_U, KC_I,
+    KC_O, KC_P, KC_MINS, KC_A, KC_S, KC_D, KC_F, KC_G,
+    KC_H, KC_J, KC_K, KC_L, KC_SCLN, KC_QUOT, KC_Z, KC_X,
+    KC_C, KC_V, KC_B, KC_N, KC_M, KC_COMM, KC_DOT, KC_SLSH,
+    KC_BSLS,
+    // _SYM, 45 keys
+    SW_WIN, LOGOUT, KC_SLSH, _______, SW_APP, KC_LT, KC_LBRC, KC_RBRC,
+    KC_GT, KC_7, KC_8, KC_9, KC_ASTR, KC_MINUS, CW_TOGG, KC_LCBR,
+    KC_LPRN, KC_RPRN, KC_RCBR, KC_DOT, KC_4, KC_5, KC_6, KC_PLUS,
+    KC_EQL, _______, OS_CMD, OS_ALT, OS_SHFT, OS_CTRL, _______, LLOCK,
+    KC_1, KC_2, KC_3, KC_0, KC_UNDS, _______, _______, _______,
+    _______, _______, _______, _______, _______,
+    // _NAV, 44 keys
+    MREC, MAC1, MAC2, MAC3, KC_BTN3, KC_PGUP, KC_MRWD, KC_MPLY,
+    KC_MFFD, KC_VOLU, KC_BTN2, KC_WH_L, KC_MS_U, KC_WH_R, KC_BTN1, KC_PGDN,
+    WEBTAB_L, KC_UP, WEBTAB_R, KC_VOLD, XXXXXXX, LDR, KC_MS_L, KC_MS_D,
+    KC_MS_R, KC_WH_U, XXXXXXX, KC_LEFT, KC_DOWN, KC_RGHT, XXXXXXX, XXXXXXX,
+    OS_CMD, OS_ALT, OS_SHFT, OS_CTRL, KC_WH_D, LLOCK, LN_BEG, WORD_L,
+    XXXXXXX, WORD_R, LN_END, XXXXXXX,
+    // _RAISE, 35 keys
+    KC_TILD, KC_F1, KC_F2, KC_F3, KC_F4, KC_F5, KC_F6, KC_F7,
+    KC_F8, KC_F9, KC_F10, LOGOUT, KC_GRV, KC_EXLM, KC_AT, KC_HASH,
+    KC_DLR, KC_PERC, KC_CIRC, KC_AMPR, KC_ASTR, KC_LPRN, KC_RPRN, _______,
+    _______, _______, LOGOUT, _______, _______, _______, _______, _______,
+    _______, _______, _______,
+    // _CONF, 24 keys
+    CLEAR, STATS, AS_UP, DT_UP, RGB_TOG, RGB_MOD, RGB_HUI, AS_DOWN,
+    DT_DOWN, RGB_RMOD, RGB_HUD, AS_RPT, DT_PRNT, _______, _______, STENO,
+    _______, _______, _______, _______, _______, QWERTY, COLEMK, _______,
+    // _STENO, 44 keys
+    STN_N1, STN_N2, STN_N3, STN_N4, STN_N5, STN_N6, STN_N7, STN_N8,
+    STN_N9, STN_NA, STN_NB, STN_NC, STN_FN, STN_S1, STN_TL, STN_PL,
+    STN_HL, STN_ST1, STN_ST3, STN_FR, STN_PR, STN_LR, STN_TR, STN_DR,
+    STN_PWR, STN_S2, STN_KL, STN_WL, STN_RL, STN_ST2, STN_ST4, STN_RR,
+    STN_BR, STN_GR, STN_SR, STN_ZR, STENO, QK_STENO_GEMINI, QK_STENO_BOLT, ST_UP,
+    STN_A, STN_O, STN_E, STN_U,
+};
 
-[_BASE] = LAYOUT(
-   QK_GESC, KC_1,    KC_2,    KC_3,    KC_4,    LT(_CONF, KC_5),            KC_6,    KC_7,    KC_8,    KC_9,    KC_0,    KC_BSPC,
-   KC_TAB,  XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,                    XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,
-   KC_LSFT, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,                    XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,
-   KC_LGUI, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, KC_BSPC,  KC_LSFT, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,
-                     KC_LCTL, KC_LGUI, MO(_NAV),LT(_SYM,KC_SPC),            KC_ENT,  MO(_RAISE), KC_RALT, KC_LGUI
-),
-
-/* COLEMAK-dhm)
- * ,-----------------------------------------.                    ,-----------------------------------------.
- * | TRNS | TRNS | TRNS | TRNS | TRNS | TRNS |                    | TRNS | TRNS | TRNS | TRNS | TRNS | TRNS |
- * |------+------+------+------+------+------|                    |------+------+------+------+------+------|
- * | TRNS |   Q  |   W  |   F  |   P  |   B  |                    |   J  |   L  |   U  |   Y  |   ;  |  -   |
- * |------+------+------+------+------+------|                    |------+------+------+------+------+------|
- * | TRNS |   A  |   R  |   S  |   T  |   G  |-------.    ,-------|   M  |   N  |   E  |   I  |   O  |  '   |
- * |------+------+------+------+------+------|  TRNS |    | TRNS  |------+------+------+------+------+------|
- * | TRNS |   Z  |   X  |   C  |   D  |   V  |-------|    |-------|   K  |   H  |   ,  |   .  |   /  |   \  |
- * `-----------------------------------------/       /     \      \-----------------------------------------'
- *                   |      |      |      | /  TRNS /       \ TRNS \  |      |      |      |
- *                   | TRNS | TRNS | TRNS |/       /         \      \ | TRNS | TRNS | TRNS |
- *                   `----------------------------'           '------''--------------------'
- */
+const layer_sparse_t PROGMEM layer_sparse[LAYER_TABLE_COUNT] = {
+    [_BASE]    = {.present = {0x01001FFF, 0x03FC0C10}, .offset = {  0,  14}, .fill = XXXXXXX},
+    [_COLEMAK] = {.present = {0xFEFFE000, 0x0003F3EF}, .offset = { 25,  43}, .fill = _______},
+    [_QWERTY]  = {.present = {0xFEFFE000, 0x0003F3EF}, .offset = { 58,  76}, .fill = _______},
+    [_SYM]     = {.present = {0xDFF9FC21, 0x03FFEDFF}, .offset = { 91, 112}, .fill = XXXXXXX},
+    [_NAV]     = {.present = {0xFEFFE7FE, 0x0003FBEF}, .offset = {136, 164}, .fill = _______},
+    [_RAISE]   = {.present = {0x017FFFFF, 0x03FC0C10}, .offset = {180, 204}, .fill = XXXXXXX},
+    [_CONF]    = {.present = {0x80DC0CC0, 0x03FC1C0D}, .offset = {215, 225}, .fill = XXXXXXX},
+    [_STENO]   = {.present = {0xFFFFFFFF, 0x00F3801F}, .offset = {239, 271}, .fill = XXXXXXX},
+};
+// clang-format on
+// END GENERATED keymaps
 
-[_COLEMAK] = LAYOUT(
-   _______, _______, _______, _______, _______, _______,                    _______, _______, _______, _______, _______, _______,
-   _______, KC_Q,    KC_W,    KC_F,    KC_P,    KC_B,                       KC_J,    KC_L,    KC_U,    KC_Y,    KC_SCLN, KC_MINS,
-   _______, KC_A,    KC_R,    KC_S,    KC_T,    KC_G,                       KC_M,    KC_N,    KC_E,    KC_I,    KC_O,    KC_QUOT,
-   _______, CMH_Z,   CMH_X,   CMH_C,   CMH_D,   KC_V,  _______,   _______,  KC_K,    CMH_H,   CMH_COMM,CMH_DOT, CMH_SLSH,KC_BSLS,
-                     _______, _______, _______, _______,           _______, _______, _______, _______
-),
-
-/* QWERTY
- * ,-----------------------------------------.                    ,-----------------------------------------.
- * | TRNS | TRNS | TRNS | TRNS | TRNS | TRNS |                    | TRNS | TRNS | TRNS | TRNS | TRNS | TRNS |
- * |------+------+------+------+------+------|                    |------+------+------+------+------+------|
- * | TRNS |   Q  |   W  |   E  |   R  |   T  |                    |   Y  |   U  |   I  |   O  |   P  |  -   |
- * |------+------+------+------+------+------|                    |------+------+------+------+------+------|
- * | TRNS |   A  |   S  |   D  |   F  |   G  |-------.    ,-------|   H  |   J  |   K  |   L  |   ;  |  '   |
- * |------+------+------+------+------+------|  TRNS |    | TRNS  |------+------+------+------+------+------|
- * | TRNS |   Z  |   X  |   C  |   V  |   B  |-------|    |-------|   N  |   M  |   ,  |   .  |   /  |   \  |
- * `-----------------------------------------/       /     \      \-----------------------------------------'
- *                   |      |      |      | /  TRNS /       \ TRNS \  |      |      |      |
- *                   | TRNS | TRNS | TRNS |/       /         \      \ | TRNS | TRNS | TRNS |
- *                   `----------------------------'           '------''--------------------'
- */
+// BEGIN GENERATED leader, edit layouts/filbar/layers.json and run tools/gen_layers.py
+#ifdef LEADER_TRIE_ENABLE
+// clang-format off
+const leader_trie_node_t PROGMEM leader_trie[] = {
+    {.children = {0x000C0800, 0x00000100}, .offset = { 1,  4}, .action = KC_NO},      // LDR
+    {.children = {0x00004000, 0x00000000}, .offset = { 5,  6}, .action = KC_NO},      // KC_L
+    {.children = {0x00040020, 0x00000000}, .offset = { 6,  8}, .action = KC_NO},      // KC_S
+    {.children = {0x0042A000, 0x00000000}, .offset = { 8, 12}, .action = G(KC_T)},    // KC_T
+    {.children = {0x00000000, 0x00000000}, .offset = { 0,  0}, .action = G(KC_SPC)},  // KC_SPC
+    {.children = {0x00000000, 0x00000000}, .offset = { 0,  0}, .action = LOGOUT},     // KC_L KC_O
+    {.children = {0x00000000, 0x00000000}, .offset = { 0,  0}, .action = G(S(KC_3))}, // KC_S KC_F
+    {.children = {0x00000000, 0x00000000}, .offset = { 0,  0}, .action = G(S(KC_4))}, // KC_S KC_S
+    {.children = {0x00000000, 0x00000000}, .offset = { 0,  0}, .action = WEBTAB_R},   // KC_T KC_N
+    {.children = {0x00000000, 0x00000000}, .offset = { 0,  0}, .action = WEBTAB_L},   // KC_T KC_P
+    {.children = {0x00000000, 0x00000000}, .offset = { 0,  0}, .action = G(S(KC_T))}, // KC_T KC_R
+    {.children = {0x00000000, 0x00000000}, .offset = { 0,  0}, .action = G(KC_W)},    // KC_T KC_W
+};
+// clang-format on
+#endif // LEADER_TRIE_ENABLE
+// END GENERATED leader
 
- [_QWERTY] = LAYOUT(
-    _______, _______, _______, _______, _______, _______,                    _______, _______, _______, _______, _______, _______,
-    _______, KC_Q,    KC_W,    KC_E,    KC_R,    KC_T,                       KC_Y,    KC_U,    KC_I,    KC_O,    KC_P,    KC_MINS,
-    _______, KC_A,    KC_S,    KC_D,    KC_F,    KC_G,                       KC_H,    KC_J,    KC_K,    KC_L,    KC_SCLN, KC_QUOT,
-    _______, QMH_Z,   QMH_X,   QMH_C,   QMH_V,   KC_B,    _______,  _______, QMH_N,   QMH_M,   QMH_COMM,QMH_DOT, KC_SLSH, KC_BSLS,
-                      _______, _______, _______, _______,                    _______, _______, _______, _______
-),
-
-/* Symbol
- * ,-----------------------------------------.                    ,-----------------------------------------.
- * |SW_WIN|      |      |      |      |LOGOUT|                    |      |      |      |      |   /  | TRNS |
- * |------+------+------+------+------+------|                    |------+------+------+------+------+------|
- * |SW_APP|  <   |   [  |   ]  |  >   |      |                    |      |   7  |   8  |   9  |   *  |   -  |
- * |------+------+------+------+------+------|                    |------+------+------+------+------+------|
- * |  CW  |  {   |   (  |   )  |  }   |      |-------.    ,-------|   .  |   4  |   5  |   6  |   +  |   =  |
- * |------+------+------+------+------+------|  TRNS |    | LLOCK |------+------+------+------+------+------|
- * | TRNS |      |      |      |      |      |-------|    |-------|      |   1  |   2  |   3  |   0  |   _  |
- * `-----------------------------------------/       /     \       \-----------------------------------------'
- *                   |      |      |      | /  TRNS /       \ TRNS \  |      |      |      |
- *                   | TRNS | TRNS | TRNS |/       /         \      \ | TRNS | TRNS | TRNS |
- *                   `----------------------------'           '------''--------------------'
- */
+// BEGIN GENERATED combos, edit layouts/filbar/layers.json and run tools/gen_layers.py
+#ifdef POSITION_COMBO_ENABLE
+// clang-format off
+const position_combo_t PROGMEM position_combos[] = {
+    {.keys = 0x0000000008008000ULL, .action = KC_ESC }, // 1,3 2,3
+    {.keys = 0x0000000010010000ULL, .action = KC_TAB }, // 1,4 2,4
+    {.keys = 0x0000000080080000ULL, .action = KC_BSPC}, // 1,7 2,7
+    {.keys = 0x0000000100100000ULL, .action = KC_DEL }, // 1,8 2,8
+};
 
-[_SYM] = LAYOUT(
-    SW_WIN,  XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, LOGOUT,                     XXXXXXX, KC_NO,   KC_NO,   KC_NO,   KC_SLSH, _______,
-    SW_APP,  KC_LT,   KC_LBRC, KC_RBRC, KC_GT,   XXXXXXX,                    KC_NO,   KC_7,    KC_8,    KC_9,    KC_ASTR, KC_MINUS,
-    CW_TOGG, KC_LCBR, KC_LPRN, KC_RPRN, KC_RCBR, XXXXXXX,                    KC_DOT,  KC_4,    KC_5,    KC_6,    KC_PLUS, KC_EQL,
-    _______, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, _______,  LLOCK,   KC_NO,   KC_1,    KC_2,    KC_3,    KC_0,    KC_UNDS,
-                      _______, _______, _______, _______,                    _______, _______, _______, _______
-),
-
-/* NAVIGATION
- * ,-----------------------------------------.                    ,-----------------------------------------.
- * |      |      |      |      |      |      |                    | PgUp | |<<  |  ||  |  >>| | VOLU | TRNS |
- * |------+------+------+------+------+------|                    |------+------+------+------+------+------|
- * |      |      | MWLt | MUp  | MWRt |      |                    | PgDn | TabL |  Up  | TabR | VOLD |      |
- * |------+------+------+------+------+------|                    |------+------+------+------+------+------|
- * |      |  M1  | MLft | MDn  | MRgt | MWUp |-------.    ,-------|      | Left | Down | Rght |      |      |
- * |------+------+------+------+------+------|       |    | LLOCK |------+------+------+------+------+------|
- * |      |      |  M1  |  M2  |  M3  | MWDn |-------|    |-------| LineB| LineB|      | WordR| LineE|      |
- * `-----------------------------------------/      /      \      \-----------------------------------------'
- *                   |     |      |      |  / TRNS /        \ TRNS \  |      |      |      |
- *                   |TRNS | TRNS | TRNS | /      /          \      \ | TRNS | TRNS | TRNS |
- *                   `-------------------''------'            '------''--------------------'
- */
+// Combos each key is in, in layout order
+const position_combo_mask_t PROGMEM position_combo_index[LAYER_TABLE_KEYS] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00,                 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x01, 0x02, 0x00,                 0x00, 0x04, 0x08, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x01, 0x02, 0x00,                 0x00, 0x04, 0x08, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                      0x00, 0x00, 0x00, 0x00,     0x00, 0x00, 0x00, 0x00,
+};
+// clang-format on
+#endif // POSITION_COMBO_ENABLE
+// END GENERATED combos
 
-[_NAV] = LAYOUT(
-    _______, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,                    KC_PGUP, KC_MRWD, KC_MPLY, KC_MFFD, KC_VOLU, _______,
-    _______, XXXXXXX, KC_WH_L, KC_MS_U, KC_WH_R, XXXXXXX,                    KC_PGDN, WEBTAB_L,KC_UP,   WEBTAB_R,KC_VOLD, XXXXXXX,
-    _______, XXXXXXX, KC_MS_L, KC_MS_D, KC_MS_R, KC_WH_U,                    XXXXXXX, KC_LEFT, KC_DOWN, KC_RGHT, XXXXXXX, XXXXXXX,
-    _______, XXXXXXX, KC_BTN1, KC_BTN2, KC_BTN3, KC_WH_D,  _______,  LLOCK,  LN_BEG,  WORD_L,  XXXXXXX, WORD_R,  LN_END,  XXXXXXX,
-                      _______, _______, _______, _______,                    _______, _______, _______, _______
-),
-
-/* RAISE
- * ,-----------------------------------------.                    ,-----------------------------------------.
- * |  ~   |  F1  |  F2  |  F3  |  F4  |  F5  |                    |  F6  |  F7  |  F8  |  F9  | F10  | LOUT |
- * |------+------+------+------+------+------|                    |------+------+------+------+------+------|
- * |  `   |   !  |   @  |   #  |   $  |   %  |                    |   ^  |   &  |   *  |   (  |   )  |      |
- * |------+------+------+------+------+------|                    |------+------+------+------+------+------|
- * |      |      |      |      |      |      |-------.    ,-------|      |      |      |      |      |      |
- * |------+------+------+------+------+------|  TRNS |    | LOGOUT|------+------+------+------+------+------|
- * |      |      |      |      |      |      |-------|    |-------|      |      |      |      |      |      |
- * `-----------------------------------------/      /      \      \-----------------------------------------'
- *                   |     |      |      |  / TRNS /        \ TRNS \  |      |      |      |
- *                   |TRNS | TRNS | TRNS | /      /          \      \ | TRNS | TRNS | TRNS |
- *                   `-------------------''------'            '------''--------------------'
- */
+// BEGIN GENERATED expand, edit layouts/filbar/layers.json and run tools/gen_layers.py
+#ifdef TEXT_EXPAND_ENABLE
+// clang-format off
+// Next state by symbol: a word boundary, then a to z
+const uint8_t PROGMEM text_expand_next[][TEXT_EXPAND_SYMBOLS] = {
+    { 1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0}, // ""
+    { 1,  2,  8,  0,  0,  0, 12,  0,  0, 16,  0,  0, 24,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 29,  0,  0,  0}, // " "
+    { 1,  0,  0,  0,  0,  0,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0}, // " a"
+    { 1,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0}, // " af"
+    { 1,  0,  0,  0,  0,  0,  0,  0,  0,  5,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0}, // " afa"
+    { 1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  6,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0}, // " afai"
+    { 7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0}, // " afaik"
+    { 1,  2,  8,  0,  0,  0, 12,  0,  0, 16,  0,  0, 24,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 29,  0,  0,  0}, // " afaik "
+    { 1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  9,  0,  0,  0,  0,  0,  0}, // " b"
+    { 1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 10,  0,  0,  0}, // " bt"
+    {11,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0}, // " btw"
+    { 1,  2,  8,  0,  0,  0, 12,  0,  0, 16,  0,  0, 24,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 29,  0,  0,  0}, // " btw "
+    { 1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 13,  0}, // " f"
+    { 1,  0,  0,  0,  0,  0,  0,  0,  0, 14,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0}, // " fy"
+    {15,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0}, // " fyi"
+    { 1,  2,  8,  0,  0,  0, 12,  0,  0, 16,  0,  0, 24,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 29,  0,  0,  0}, // " fyi "
+    { 1,  0,  0,  0,  0,  0,  0,  0,  0, 17,  0,  0,  0, 21,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0}, // " i"
+    { 1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 18,  0,  0,  0,  0,  0,  0,  0,  0}, // " ii"
+    { 1,  0,  0, 19,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0}, // " iir"
+    {20,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0}, // " iirc"
+    { 1,  2,  8,  0,  0,  0, 12,  0,  0, 16,  0,  0, 24,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 29,  0,  0,  0}, // " iirc "
+    { 1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 22,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0}, // " im"
+    {23,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0}, // " imo"
+    { 1,  2,  8,  0,  0,  0, 12,  0,  0, 16,  0,  0, 24,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 29,  0,  0,  0}, // " imo "
+    { 1,  0,  0,  0,  0,  0,  0, 25,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0}, // " l"
+    { 1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 26,  0,  0,  0,  0,  0,  0}, // " lg"
+    { 1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 27,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0}, // " lgt"
+    {28,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0}, // " lgtm"
+    { 1,  2,  8,  0,  0,  0, 12,  0,  0, 16,  0,  0, 24,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 29,  0,  0,  0}, // " lgtm "
+    { 1,  0,  0,  0,  0,  0,  0,  0,  0, 30,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0}, // " w"
+    { 1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 31,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0}, // " wi"
+    {32,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0}, // " wip"
+    { 1,  2,  8,  0,  0,  0, 12,  0,  0, 16,  0,  0, 24,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 29,  0,  0,  0}, // " wip "
+};
 
-[_RAISE] = LAYOUT(
-   KC_TILD, KC_F1,   KC_F2,   KC_F3,   KC_F4,   KC_F5,                      KC_F6,   KC_F7,   KC_F8,   KC_F9,   KC_F10,  LOGOUT,
-   KC_GRV,  KC_EXLM, KC_AT,   KC_HASH, KC_DLR,  KC_PERC,                    KC_CIRC, KC_AMPR, KC_ASTR, KC_LPRN, KC_RPRN, XXXXXXX,
-   _______, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,                    XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,
-   _______, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, _______,  LOGOUT,  XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,
-                      _______, _______, _______, _______,                    _______, _______, _______, _______
-),
-
-/* ADJUST (never used actually, saved from original config)
- * ,-----------------------------------------.                    ,-----------------------------------------.
- * |      |      |      |      |      |      |                    |CLEAR |      |      |      |      |      |
- * |------+------+------+------+------+------|                    |------+------+------+------+------+------|
- * |      |      |      |      |      |      |                    |  RGB | MOD U| HUE U|      |      |      |
- * |------+------+------+------+------+------|                    |------+------+------+------+------+------|
- * |      |      |      |      |      |      |-------.    ,-------|      | MOD D| HUE D|      |      |      |
- * |------+------+------+------+------+------|       |    |       |------+------+------+------+------+------|
- * |      |      |      |      |      |      |-------|    |-------|      |      |      |      |      |      |
- * `-----------------------------------------/       /     \      \-----------------------------------------'
- *                   |      |      |      | /       /       \      \  |      |      |      |
- *                   |      |      |      |/       /         \      \ |QWERTY|COLEMK|      |
- *                   `--------------------''------'           '------''--------------------'
- */
+// The expansion a state completes, plus one
+const uint8_t PROGMEM text_expand_match[] = {
+    0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 3,
+    0, 0, 0, 0, 4, 0, 0, 5, 0, 0, 0, 0, 6, 0, 0, 0,
+    7,
+};
 
-  [_CONF] = LAYOUT(
-    KC_NO,   KC_NO,   KC_NO,   KC_NO,   KC_NO,   KC_NO,                      CLEAR,   KC_NO,    KC_NO,  KC_NO,   AS_UP,   DT_UP,
-    KC_NO,   KC_NO,   KC_NO,   KC_NO,   KC_NO,   KC_NO,                      RGB_TOG, RGB_MOD,  RGB_HUI,KC_NO,   AS_DOWN,   DT_DOWN,
-    KC_NO,   KC_NO,   KC_NO,   KC_NO,   KC_NO,   KC_NO,                      KC_NO,   RGB_RMOD, RGB_HUD,KC_NO,   AS_RPT,   DT_PRNT,
-    KC_NO,   KC_NO,   KC_NO,   KC_NO,   KC_NO,   KC_NO,  _______,  _______,  KC_NO,   KC_NO,    KC_NO,  KC_NO,   KC_NO,   KC_NO,
-                      _______, _______, _______, _______,                    _______, QWERTY,   COLEMK, _______
-  )
+const text_expand_t PROGMEM text_expand_words[] = {
+    {.text =   0, .typed = 5}, // afaik
+    {.text =  17, .typed = 3}, // btw
+    {.text =  28, .typed = 3}, // fyi
+    {.text =  49, .typed = 4}, // iirc
+    {.text =  73, .typed = 3}, // imo
+    {.text =  87, .typed = 4}, // lgtm
+    {.text = 104, .typed = 3}, // wip
 };
+
+const char PROGMEM text_expand_text[] =
+    "as far as I know\0"
+    "by the way\0"
+    "for your information\0"
+    "if I remember correctly\0"
+    "in my opinion\0"
+    "looks good to me\0"
+    "work in progress";
 // clang-format on
+#endif // TEXT_EXPAND_ENABLE
+// END GENERATED expand
 
 /* The Liatris LED is hella bright, turn that off for dark rooms.
  */
 void keyboard_pre_init_user(void) {
+    boot_profile_mark(BOOT_PRE_INIT);
+
+    // Paint the stacks before anything else gets to use them
+    mem_stats_init();
+
     // Set our LED pin as output
     setPinOutput(24);
     // Turn the LED off
@@ -253,10 +346,54 @@ void keyboard_pre_init_user(void) {
     writePinHigh(24);
 }
 
+/* Deferred init stages, these run one per scan once the keyboard is usable
+ */
+#ifdef RGB_MATRIX_ENABLE
+static void _start_rgb(void) {
+    rgb_matrix_enable_noeeprom();
+}
+#endif // RGB_MATRIX_ENABLE
+
+#ifdef OLED_ENABLE
+static bool oled_started = false;
+
+static void _start_oled(void) {
+    oled_started = true;
+}
+#endif // OLED_ENABLE
+
+/* Anything counted while booting would only skew the instrumentation */
+static void _reset_stats(void) {
+    profiler_reset();
+    scan_monitor_reset();
+    key_latency_reset();
+    split_stats_reset();
+}
+
 /* Standard init with the default layer set here (see definition above)
  */
 void keyboard_post_init_user(void) {
+    boot_profile_mark(BOOT_POST_INIT);
+
     default_layer_set(1 << DEFAULT_LAYER );
+    keymap_cache_init();
+    macro_recorder_init();
+    split_sync_init();
+    split_stats_init();
+
+#   ifdef RGB_MATRIX_ENABLE
+    // Hold the effects back until the host is done with us, the slave
+    // half follows whatever the master does
+    if (is_keyboard_master() && rgb_matrix_is_enabled()) {
+        rgb_matrix_disable_noeeprom();
+        deferred_init_add(_start_rgb);
+    }
+    deferred_init_add(heatmap_init);
+#   endif // RGB_MATRIX_ENABLE
+#   ifdef OLED_ENABLE
+    deferred_init_add(_start_oled);
+#   endif // OLED_ENABLE
+    deferred_init_add(_reset_stats);
 
 #   ifdef CONSOLE_ENABLE
     debug_enable=true;
@@ -266,11 +403,12 @@ void keyboard_post_init_user(void) {
 #   endif // CONSOLE_ENABLE
 }
 
-/* This is needed to handle retro shift for the tap-hold mods on the home (or lower) row
+/* This is needed to handle retro shift for the tap-hold keys (the layer-taps now that the
+ * home row mods are one-shots on SYM and NAV)
  * Without this they will not be shifted.
  *
  * This is used in conjuntion with auto shift (rules.mk) and retro_shift must be configured
- * to a value in config.h.  When tapping and holding a home-row mod, if you hold it and
+ * to a value in config.h.  When tapping and holding a tap-hold key, if you hold it and
  * release longer than the auto shift timeout, but less than the retro shift timeout then you
  * will get the shifted tap key.  If you hold it longer than retro-shift timeout you will get
  * not shifted keystroke and the mod will be held until you release (great for ctrl clicks or such)
@@ -286,6 +424,16 @@ bool get_custom_auto_shifted_key(uint16_t keycode, keyrecord_t *record) {
     return false;
 }
 
+/* QMK's default auto shift press, plus telling the expander what went out
+ */
+void autoshift_press_user(uint16_t keycode, bool shifted, keyrecord_t *record) {
+    if (shifted) {
+        add_weak_mods(MOD_BIT(KC_LSFT));
+    }
+    register_code16(IS_RETRO(keycode) ? keycode & 0xFF : keycode);
+    text_expand_autoshift_press(keycode, shifted);
+}
+
 /* This is used to like up the liatris LED as an indicator that we are in caps word mode
  *
  * In the future this could also be represented on the LED screens.
@@ -298,13 +446,74 @@ void caps_word_set_user(bool active) {
     }
 }
 
+/* The slave never sees caps word itself, mirror the master's LED
+ */
+void split_sync_update_user(const split_sync_state_t *state) {
+    caps_word_set_user(state->caps_word);
+}
+
+/* One-shot modifiers on the SYM and NAV home rows, see features/oneshot.h.  Layer keys drop a
+ * queued modifier, and neither they nor the other one-shots use one up, so modifiers stack and
+ * carry from the layer to the next key typed.
+ */
+oneshot_state os_shft_state = os_up_unqueued;
+oneshot_state os_ctrl_state = os_up_unqueued;
+oneshot_state os_alt_state  = os_up_unqueued;
+oneshot_state os_cmd_state  = os_up_unqueued;
+
+static bool _is_layer_key(uint16_t keycode, keyrecord_t *record) {
+    return IS_QK_MOMENTARY(keycode) || (IS_QK_LAYER_TAP(keycode) && record->tap.count == 0);
+}
+
+bool is_oneshot_cancel_key(uint16_t keycode, keyrecord_t *record) {
+    return _is_layer_key(keycode, record) || keycode == STENO;
+}
+
+bool is_oneshot_ignored_key(uint16_t keycode, keyrecord_t *record) {
+    switch (keycode) {
+        case OS_SHFT:
+        case OS_CTRL:
+        case OS_ALT:
+        case OS_CMD:
+        case LLOCK:
+            return true;
+    }
+    return _is_layer_key(keycode, record) || IS_MODIFIER_KEYCODE(keycode);
+}
+
+/* Auto Shift holds a key back until its release, and update_oneshot() has let a queued
+ * one-shot go on that release before Auto Shift sends the key.  So while a one-shot modifier is
+ * down or queued nothing is auto shifted: the key goes out on press, under the modifier.
+ * Otherwise this is QMK's default set plus the retro shift keys above.
+ */
+bool get_auto_shifted_key(uint16_t keycode, keyrecord_t *record) {
+    if (os_shft_state != os_up_unqueued || os_ctrl_state != os_up_unqueued || os_alt_state != os_up_unqueued || os_cmd_state != os_up_unqueued) {
+        return false;
+    }
+
+    switch (keycode) {
+        case AUTO_SHIFT_ALPHA:
+        case AUTO_SHIFT_NUMERIC:
+        case KC_TAB:
+        case AUTO_SHIFT_SYMBOLS:
+            return true;
+    }
+    return get_custom_auto_shifted_key(keycode, record);
+}
+
+/* Shift turns a cmd-tab around instead of ending it
+ */
+bool is_swapper_ignored_key(uint16_t keycode) {
+    return keycode == OS_SHFT;
+}
+
 /* This handles treating a layer-top as a modifier in some situations.  For example, if you
  * want the SYM layer switch to respond like cmd-tab you will need to register and hold cmd
  * if tab is detected.
  *
- * This works mostly well but has some glitches that I need to work with.  For instance if
- * if you press shift it will unregister cmd since it is seeing a key other than tab which
- * breaks the convenient cmd-tab / cmd-shft-tab functionality.  It also has some difficulty
+ * This works mostly well but has some glitches that I need to work with.  A plain shift
+ * will unregister cmd since it is seeing a key other than tab, the one-shot shift does not
+ * (see is_swapper_ignored_key above) so cmd-tab / cmd-shft-tab still work.  It also has some difficulty
  * tracking states when you are using cmd for different functions like cmd-` and cmd-tab.
  * the fix is likely to have a single function that takes state and a map of input to actions
  * as well as keys that will work as normal without deregistering the cmd (like shift)
@@ -313,15 +522,267 @@ void caps_word_set_user(bool active) {
  */
 bool sw_app_active = false;
 bool sw_win_active = false;
-bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+static bool _process_record_user(uint16_t keycode, keyrecord_t *record) {
+
+    // Bring the lights back before anything else sees the key
+    idle_wake();
+
+    key_latency_record(keycode, record);
+    if (record->event.pressed) {
+        rgb_governor_keypress();
+    }
+
+    PROFILE_ENTER(PROF_LAYER_LOCK);
+    const bool layer_lock_continue = process_layer_lock(keycode, record, LLOCK);
+    PROFILE_EXIT(PROF_LAYER_LOCK);
+    if (!layer_lock_continue) {
+        return false;
+    }
+
+    // Before the steno, leader and recorder hooks so every key can use up a one-shot
+    update_oneshot(&os_shft_state, KC_LSFT, OS_SHFT, keycode, record);
+    update_oneshot(&os_ctrl_state, KC_LCTL, OS_CTRL, keycode, record);
+    update_oneshot(&os_alt_state, KC_LALT, OS_ALT, keycode, record);
+    update_oneshot(&os_cmd_state, KC_LGUI, OS_CMD, keycode, record);
+
+    // The steno layer's keys only ever make chords
+    if (!process_steno_chord(keycode, record, ST_UP)) {
+        return false;
+    }
 
-    if (!process_layer_lock(keycode, record, LLOCK)) {
+    // Keys typed after LDR belong to the leader sequence
+    if (!process_leader_trie(keycode, record, LDR)) {
+        return false;
+    }
+    if (!process_macro_recorder(keycode, record, MREC, MAC1)) {
         return false;
     }
 
-    /* there are some glitches...  shift exits, and you need to release SYM between different swaps that use the same mod */
+    /* there are some glitches...  plain shift exits, and you need to release SYM between different swaps that use the same mod */
+    PROFILE_ENTER(PROF_SWAPPER);
     update_swapper( &sw_app_active, KC_LGUI, KC_TAB, SW_APP, keycode, record );
     update_swapper( &sw_win_active, KC_LGUI, KC_GRV, SW_WIN, keycode, record );
+    PROFILE_EXIT(PROF_SWAPPER);
+
+    switch (keycode) {
+        case STATS:
+            if (record->event.pressed && (get_mods() & MOD_MASK_SHIFT)) {
+                split_stats_bench_start();
+            } else if (record->event.pressed) {
+                profiler_print();
+                scan_monitor_print();
+                key_latency_print();
+                mem_stats_print();
+                boot_profile_print();
+                idle_print();
+                rgb_governor_print();
+                split_stats_print();
+            }
+            return false;
+
+        case STENO:
+            if (record->event.pressed) {
+                layer_lock_invert(_STENO);
+            }
+            return false;
+
+        /* These end up writing to EEPROM, blame any slow scan on that */
+        case RGB_TOG:
+        case RGB_MOD:
+        case RGB_RMOD:
+        case RGB_HUI:
+        case RGB_HUD:
+        case CLEAR:
+            scan_monitor_mark(SCAN_SUBSYS_EEPROM);
+            break;
+    }
+
+    return true;
+}
+
+/* Runs before tap-hold sees the key, see features/position_combo.h
+ */
+bool pre_process_record_user(uint16_t keycode, keyrecord_t *record) {
+    return pre_process_position_combo(keycode, record);
+}
+
+/* Everything in here is timed as a single profiler zone, see features/profiler.h
+ */
+bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+    PROFILE_ENTER(PROF_PROCESS_RECORD);
+    const bool result = _process_record_user(keycode, record);
+    PROFILE_EXIT(PROF_PROCESS_RECORD);
+    return result;
+}
+
+/* Runs once the key has been sent, see features/text_expand.h
+ */
+void post_process_record_user(uint16_t keycode, keyrecord_t *record) {
+    post_process_text_expand(keycode, record);
+}
+
+void matrix_scan_user(void) {
+    scan_monitor_mark(SCAN_SUBSYS_KEYS);
+    rgb_governor_scan_start();
+    heatmap_scan();
+    key_trace_scan();
+
+    if (idle_housekeeping_due()) {
+        PROFILE_ENTER(PROF_LAYER_LOCK_TASK);
+        layer_lock_task();
+        PROFILE_EXIT(PROF_LAYER_LOCK_TASK);
+    }
+}
+
+/* State the slave half renders from, see features/split_sync.h
+ */
+static split_sync_state_t _sync_state(void) {
+    split_sync_state_t sync = {
+        .default_layer = get_highest_layer(default_layer_state),
+        .idle_tier     = idle_get_tier(),
+        .caps_word     = is_caps_word_on(),
+    };
+    return sync;
+}
+
+/* Runs once at the end of every main loop iteration
+ */
+void housekeeping_task_user(void) {
+    scan_monitor_task();
+    host_hook_task();
+    idle_task();
+    leader_trie_task();
+    position_combo_task();
+    macro_recorder_task();
+    keymap_cache_refresh();
+
+    const split_sync_state_t sync = _sync_state();
+    split_sync_task(&sync);
+    split_stats_task();
+
+    // Optional work, throttled when the keyboard has been idle for a long time
+    if (idle_housekeeping_due()) {
+        mem_stats_task();
+    }
+
+    boot_profile_task();
+    deferred_init_task();
+    if (deferred_init_done()) {
+        boot_profile_mark(BOOT_DEFERRED_DONE);
+    }
+}
+
+#if defined(RAW_ENABLE) && !defined(VIA_ENABLE)
+/* Lets host tools ask what each key does right now
+ */
+void raw_hid_receive(uint8_t *data, uint8_t length) {
+    if (keymap_cache_raw_hid(data, length)) {
+        raw_hid_send(data, length);
+    }
+}
+#endif // RAW_ENABLE
 
+/* Input is usable once the host has configured us, anything non-critical
+ * waits for that (see features/deferred_init.h)
+ */
+void notify_usb_device_state_change_user(enum usb_device_state usb_device_state) {
+    const bool configured = usb_device_state == USB_DEVICE_STATE_CONFIGURED;
+
+    boot_profile_usb_state(configured);
+    if (configured) {
+        deferred_init_usb_configured();
+    }
+}
+
+void suspend_wakeup_init_user(void) {
+    boot_profile_wake();
+}
+
+#ifdef HOST_HOOK_ENABLE
+/* Every keyboard report passes through here on its way to the host
+ */
+void host_hook_keyboard_report_user(report_keyboard_t *report) {
+    boot_profile_report_sent();
+#   ifdef KEY_LATENCY_ENABLE
+    key_latency_keyboard_report(report);
+#   endif // KEY_LATENCY_ENABLE
+#   ifdef MACRO_RECORDER_ENABLE
+    macro_recorder_keyboard_report(report);
+#   endif // MACRO_RECORDER_ENABLE
+}
+
+#   ifdef NKRO_ENABLE
+void host_hook_nkro_report_user(report_nkro_t *report) {
+    boot_profile_report_sent();
+#       ifdef KEY_LATENCY_ENABLE
+    key_latency_nkro_report(report);
+#       endif // KEY_LATENCY_ENABLE
+}
+#   endif // NKRO_ENABLE
+#endif // HOST_HOOK_ENABLE
+
+#ifdef RGB_MATRIX_ENABLE
+/* Called after each chunk of LEDs has been rendered
+ */
+bool rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max) {
+    rgb_governor_chunk_done();
     return true;
 }
+
+/* Called once per frame right before the LEDs are flushed
+ */
+bool rgb_matrix_indicators_user(void) {
+    scan_monitor_mark(SCAN_SUBSYS_RGB);
+    rgb_governor_frame_done();
+    return true;
+}
+#endif // RGB_MATRIX_ENABLE
+
+#ifdef OLED_ENABLE
+/* Legends of the active layer while one is on, otherwise leave the drawing to
+ * the keyboard.  The OLED is kept blank until the deferred init has run and
+ * while idle
+ */
+bool oled_task_user(void) {
+    scan_monitor_mark(SCAN_SUBSYS_OLED);
+    if (!oled_started || idle_get_tier() >= IDLE_OFF) {
+        return false;
+    }
+    return !oled_legend_render();
+}
+
+/* Legends for our own keycodes, see features/oled_legend.h
+ */
+const char *oled_legend_user(uint16_t keycode) {
+    switch (keycode) {
+        case LLOCK:
+            return "Lk";
+        case SW_APP:
+            return "Sa";
+        case SW_WIN:
+            return "Sw";
+        case LDR:
+            return "Ld";
+        case MREC:
+            return "Mr";
+        case MAC1:
+            return "M1";
+        case MAC2:
+            return "M2";
+        case MAC3:
+            return "M3";
+        case STENO:
+            return "St";
+        case OS_SHFT:
+            return "s";
+        case OS_CTRL:
+            return "c";
+        case OS_ALT:
+            return "a";
+        case OS_CMD:
+            return "g";
+        default:
+            return NULL;
+    }
+}
+#endif // OLED_ENABLE
@@ -0,0 +1,130 @@
+// Generated by tools/gen_layers.py from layouts/filbar/layers.json, do not edit.
+#include "layer_tables.h"
+
+// clang-format off
+const layer_table_t layer_table_bound[MATRIX_ROWS][MATRIX_COLS] = LAYOUT(
+    0xE9, 0xF9, 0xF9, 0xF9, 0xF9, 0xF9,                 0xF9, 0xF9, 0xF9, 0xF9, 0xF9, 0xE1,
+    0xE9, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,                 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xC9, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,                 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xC1, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x81,     0xB9, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                      0x81, 0x81, 0x81, 0x81,     0x81, 0xC1, 0xC1, 0x81
+);
+
+const layer_table_t layer_table_tap_hold[MATRIX_ROWS][MATRIX_COLS] = LAYOUT(
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x01,                 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00,                 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00,                 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                      0x00, 0x00, 0x00, 0x01,     0x00, 0x00, 0x00, 0x00
+);
+
+const uint8_t layer_table_keys[MATRIX_ROWS][MATRIX_COLS] = LAYOUT(
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01,                 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01,                 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01,                 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,     0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+                      0x05, 0x05, 0x05, 0x05,     0x06, 0x06, 0x06, 0x06
+);
+
+const uint8_t layer_table_slots[MATRIX_ROWS][MATRIX_COLS] = LAYOUT(
+    1,  2,  3,  4,  5,  6,              7,  8,  9,  10, 11, 12,
+    13, 14, 15, 16, 17, 18,             19, 20, 21, 22, 23, 24,
+    25, 26, 27, 28, 29, 30,             31, 32, 33, 34, 35, 36,
+    37, 38, 39, 40, 41, 42, 43,     44, 45, 46, 47, 48, 49, 50,
+                51, 52, 53, 54,     55, 56, 57, 58
+);
+// clang-format on
+
+const HSV layer_table_colours[LAYER_TABLE_COUNT] = {
+    [0] = {HSV_OFF},     // _BASE
+    [1] = {HSV_GREEN},   // _COLEMAK
+    [2] = {HSV_RED},     // _QWERTY
+    [3] = {HSV_WHITE},   // _SYM
+    [4] = {HSV_AZURE},   // _NAV
+    [5] = {HSV_PURPLE},  // _RAISE
+    [6] = {HSV_RED},     // _CONF
+    [7] = {HSV_GOLD},    // _STENO
+};
+
+#ifdef RGB_MATRIX_ENABLE
+// clang-format off
+const layer_table_heat_t layer_table_heat[LAYER_TABLE_HEAT_LEDS][LAYER_TABLE_HEAT_NEIGHBOURS] = {
+    {{0, 0}}, // 0
+    {{0, 0}}, // 1
+    {{0, 0}}, // 2
+    {{0, 0}}, // 3
+    {{0, 0}}, // 4
+    {{6, 16}, {11, 16}, {12, 16}, {7, 11}, {13, 10}, {17, 10}, {18, 9}, {19, 3}}, // 5
+    {{5, 16}, {7, 16}, {11, 16}, {12, 16}, {13, 16}, {8, 11}, {14, 10}, {18, 10}}, // 6
+    {{6, 16}, {8, 16}, {12, 16}, {13, 16}, {14, 16}, {5, 11}, {9, 11}, {19, 10}}, // 7
+    {{7, 16}, {9, 16}, {13, 16}, {14, 16}, {15, 16}, {6, 11}, {10, 11}, {20, 10}}, // 8
+    {{8, 16}, {10, 16}, {14, 16}, {15, 16}, {16, 16}, {7, 11}, {21, 10}, {20, 9}}, // 9
+    {{9, 16}, {15, 16}, {16, 16}, {8, 11}, {22, 10}, {14, 9}, {21, 9}, {20, 2}}, // 10
+    {{5, 16}, {6, 16}, {12, 16}, {17, 16}, {18, 16}, {13, 11}, {19, 10}, {23, 10}}, // 11
+    {{5, 16}, {6, 16}, {7, 16}, {11, 16}, {13, 16}, {17, 16}, {18, 16}, {19, 16}}, // 12
+    {{6, 16}, {7, 16}, {8, 16}, {12, 16}, {14, 16}, {18, 16}, {19, 16}, {20, 16}}, // 13
+    {{7, 16}, {8, 16}, {9, 16}, {13, 16}, {15, 16}, {19, 16}, {20, 16}, {21, 16}}, // 14
+    {{8, 16}, {9, 16}, {10, 16}, {14, 16}, {16, 16}, {20, 16}, {21, 16}, {22, 16}}, // 15
+    {{9, 16}, {10, 16}, {15, 16}, {21, 16}, {22, 16}, {29, 14}, {14, 11}, {28, 10}}, // 16
+    {{11, 16}, {12, 16}, {18, 16}, {23, 16}, {24, 16}, {19, 11}, {5, 10}, {25, 10}}, // 17
+    {{11, 16}, {12, 16}, {13, 16}, {17, 16}, {19, 16}, {23, 16}, {24, 16}, {25, 16}}, // 18
+    {{12, 16}, {13, 16}, {14, 16}, {18, 16}, {20, 16}, {24, 16}, {25, 16}, {26, 16}}, // 19
+    {{13, 16}, {14, 16}, {15, 16}, {19, 16}, {21, 16}, {25, 16}, {26, 16}, {27, 16}}, // 20
+    {{14, 16}, {15, 16}, {16, 16}, {20, 16}, {22, 16}, {26, 16}, {27, 16}, {28, 16}}, // 21
+    {{15, 16}, {16, 16}, {21, 16}, {27, 16}, {28, 16}, {29, 16}, {20, 11}, {10, 10}}, // 22
+    {{17, 16}, {18, 16}, {24, 16}, {25, 11}, {11, 10}, {12, 6}, {19, 5}, {30, 3}}, // 23
+    {{17, 16}, {18, 16}, {19, 16}, {23, 16}, {25, 16}, {30, 16}, {26, 11}, {12, 10}}, // 24
+    {{18, 16}, {19, 16}, {20, 16}, {24, 16}, {26, 16}, {30, 16}, {31, 14}, {23, 11}}, // 25
+    {{19, 16}, {20, 16}, {21, 16}, {25, 16}, {27, 16}, {30, 16}, {31, 16}, {24, 11}}, // 26
+    {{20, 16}, {21, 16}, {22, 16}, {26, 16}, {28, 16}, {31, 16}, {32, 16}, {30, 14}}, // 27
+    {{21, 16}, {22, 16}, {27, 16}, {29, 16}, {31, 16}, {32, 16}, {33, 16}, {26, 11}}, // 28
+    {{22, 16}, {28, 16}, {33, 16}, {16, 14}, {27, 11}, {21, 10}, {32, 9}, {15, 3}}, // 29
+    {{24, 16}, {25, 16}, {26, 16}, {31, 16}, {27, 14}, {32, 11}, {19, 10}, {20, 8}}, // 30
+    {{26, 16}, {27, 16}, {28, 16}, {30, 16}, {32, 16}, {25, 14}, {21, 10}, {20, 8}}, // 31
+    {{27, 16}, {28, 16}, {31, 16}, {33, 16}, {26, 11}, {30, 11}, {22, 10}, {29, 9}}, // 32
+    {{28, 16}, {29, 16}, {32, 16}, {22, 7}, {27, 7}, {31, 4}}, // 33
+    {{0, 0}}, // 34
+    {{0, 0}}, // 35
+    {{0, 0}}, // 36
+    {{0, 0}}, // 37
+    {{0, 0}}, // 38
+    {{40, 16}, {45, 16}, {46, 16}, {41, 11}, {51, 10}, {47, 9}, {52, 9}, {53, 2}}, // 39
+    {{39, 16}, {41, 16}, {45, 16}, {46, 16}, {47, 16}, {42, 11}, {52, 10}, {53, 9}}, // 40
+    {{40, 16}, {42, 16}, {46, 16}, {47, 16}, {48, 16}, {39, 11}, {43, 11}, {53, 10}}, // 41
+    {{41, 16}, {43, 16}, {47, 16}, {48, 16}, {49, 16}, {40, 11}, {44, 11}, {54, 10}}, // 42
+    {{42, 16}, {44, 16}, {48, 16}, {49, 16}, {50, 16}, {41, 11}, {47, 10}, {54, 10}}, // 43
+    {{43, 16}, {49, 16}, {50, 16}, {42, 11}, {48, 10}, {56, 10}, {55, 9}, {54, 3}}, // 44
+    {{39, 16}, {40, 16}, {46, 16}, {51, 16}, {52, 16}, {57, 14}, {47, 11}, {58, 10}}, // 45
+    {{39, 16}, {40, 16}, {41, 16}, {45, 16}, {47, 16}, {51, 16}, {52, 16}, {53, 16}}, // 46
+    {{40, 16}, {41, 16}, {42, 16}, {46, 16}, {48, 16}, {52, 16}, {53, 16}, {54, 16}}, // 47
+    {{41, 16}, {42, 16}, {43, 16}, {47, 16}, {49, 16}, {53, 16}, {54, 16}, {55, 16}}, // 48
+    {{42, 16}, {43, 16}, {44, 16}, {48, 16}, {50, 16}, {54, 16}, {55, 16}, {56, 16}}, // 49
+    {{43, 16}, {44, 16}, {49, 16}, {55, 16}, {56, 16}, {48, 11}, {54, 10}, {63, 10}}, // 50
+    {{45, 16}, {46, 16}, {52, 16}, {57, 16}, {58, 16}, {59, 16}, {53, 11}, {39, 10}}, // 51
+    {{45, 16}, {46, 16}, {47, 16}, {51, 16}, {53, 16}, {58, 16}, {59, 16}, {60, 16}}, // 52
+    {{46, 16}, {47, 16}, {48, 16}, {52, 16}, {54, 16}, {59, 16}, {60, 16}, {61, 16}}, // 53
+    {{47, 16}, {48, 16}, {49, 16}, {53, 16}, {55, 16}, {60, 16}, {61, 16}, {62, 16}}, // 54
+    {{48, 16}, {49, 16}, {50, 16}, {54, 16}, {56, 16}, {61, 16}, {62, 16}, {63, 16}}, // 55
+    {{49, 16}, {50, 16}, {55, 16}, {62, 16}, {63, 16}, {54, 11}, {44, 10}, {61, 10}}, // 56
+    {{51, 16}, {58, 16}, {64, 16}, {45, 14}, {59, 11}, {52, 10}, {65, 9}, {46, 3}}, // 57
+    {{51, 16}, {52, 16}, {57, 16}, {59, 16}, {64, 16}, {65, 16}, {66, 16}, {60, 11}}, // 58
+    {{51, 16}, {52, 16}, {53, 16}, {58, 16}, {60, 16}, {65, 16}, {66, 16}, {67, 14}}, // 59
+    {{52, 16}, {53, 16}, {54, 16}, {59, 16}, {61, 16}, {66, 16}, {67, 16}, {58, 11}}, // 60
+    {{53, 16}, {54, 16}, {55, 16}, {60, 16}, {62, 16}, {67, 16}, {66, 14}, {59, 11}}, // 61
+    {{54, 16}, {55, 16}, {56, 16}, {61, 16}, {63, 16}, {67, 16}, {60, 11}, {49, 10}}, // 62
+    {{55, 16}, {56, 16}, {62, 16}, {61, 11}, {50, 10}, {49, 6}, {54, 5}, {67, 3}}, // 63
+    {{57, 16}, {58, 16}, {65, 16}, {51, 7}, {59, 7}, {66, 4}}, // 64
+    {{58, 16}, {59, 16}, {64, 16}, {66, 16}, {60, 11}, {67, 11}, {51, 10}, {57, 9}}, // 65
+    {{58, 16}, {59, 16}, {60, 16}, {65, 16}, {67, 16}, {61, 14}, {52, 10}, {53, 8}}, // 66
+    {{60, 16}, {61, 16}, {62, 16}, {66, 16}, {59, 14}, {65, 11}, {54, 10}, {53, 8}}, // 67
+};
+
+const uint8_t layer_table_heat_count[LAYER_TABLE_HEAT_LEDS] = {
+    0, 0, 0, 0, 0, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+    8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+    8, 6, 0, 0, 0, 0, 0, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+    8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+    6, 8, 8, 8,
+};
+// clang-format on
+#endif // RGB_MATRIX_ENABLE
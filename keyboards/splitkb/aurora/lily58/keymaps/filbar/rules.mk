@@ -11,5 +11,13 @@ DYNAMIC_TAPPING_TERM_ENABLE = yes
 # To enable debug messaging via qmk console set to 'yes'
 CONSOLE_ENABLE = no
 
-SRC += features/layer_lock.c
-SRC += features/swapper.c
+# Shared features and their switches live in users/filbar/rules.mk, turn
+# the optional ones on here
+LEADER_TRIE_ENABLE = yes
+POSITION_COMBO_ENABLE = yes
+TEXT_EXPAND_ENABLE = yes
+MACRO_RECORDER_ENABLE = yes
+STENO_CHORD_ENABLE = yes
+
+# Generated with the keymap, see tools/gen_layers.py
+SRC += layer_tables.c
@@ -0,0 +1,644 @@
+#!/usr/bin/env python3
+"""Keymap generator for the filbar boards.
+
+Reads the shared layer definition in layouts/filbar/layers.json and writes,
+for every board listed there:
+
+  * the generated parts of the board's keymap.c: the layer enum,
+    DEFAULT_LAYER, the custom keycodes and key aliases, and keymaps[]
+    (between the BEGIN/END GENERATED markers, the rest of the file is left
+    alone)
+  * layer_tables.h and layer_tables.c next to it: constant per-key tables
+    (the layers each key is bound on, the layers it is a tap-hold key on,
+    its hand and cluster, its position in the layout) and the indicator
+    colour of each layer, laid out through the board's LAYOUT macro so they
+    index like keymaps[]
+  * for boards whose spec names their keyboard.json, the typing heatmap's
+    neighbour lists in layer_tables.c for features/heatmap.c, worked out
+    from the RGB matrix layout the way heatmap_init() otherwise does on
+    the keyboard
+  * a sparse copy of keymaps[] in keymap.c for features/sparse_keymap.c:
+    per layer, a bitmap of the keys that differ from the layer's most
+    common keycode and those keys packed in layout order
+  * the leader sequences as a trie in keymap.c for features/leader_trie.c,
+    one node per sequence prefix with a bitmap of the keys that extend it
+  * the combos in keymap.c for features/position_combo.c, by layout
+    position: each combo's keys as a bitmap and each key's combos
+  * the abbreviations as an Aho-Corasick automaton in keymap.c for
+    features/text_expand.c, with the failure links folded into a full
+    transition table
+
+Run it after editing layers.json, and commit what it writes:
+
+    tools/gen_layers.py
+    tools/gen_layers.py --check     # exit non-zero if anything is stale
+"""
+
+import argparse
+import math
+import os
+import re
+import sys
+
+import latency_model
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SPEC = 'layouts/filbar/layers.json'
+
+CORE_ROWS = 4
+CORE_COLS = 12
+TRANS = ('_______', 'KC_TRNS', 'KC_TRANSPARENT')
+NONE = ('XXXXXXX', 'KC_NO')
+
+# Bits per word of a sparse layer's presence bitmap
+SPARSE_WORD = 32
+
+# Keys in a combo at most, POSITION_COMBO_KEYS in features/position_combo.h
+COMBO_KEYS = 4
+
+# Keys a leader sequence is typed with, KC_A to KC_SLSH in HID order, and
+# what a leader or combo action may be: a basic keycode in mod wrappers
+LEADER_KEYS = ['KC_%s' % key for key in
+               'A B C D E F G H I J K L M N O P Q R S T U V W X Y Z 1 2 3 4 5 6 7 8 9 0 '
+               'ENT ESC BSPC TAB SPC MINS EQL LBRC RBRC BSLS NUHS SCLN QUOT GRV COMM DOT SLSH'.split()]
+ACTION = re.compile(r'((?:[LR]?(?:C|S|A|G|CTL|SFT|ALT|GUI|CMD|OPT))\()*KC_\w+\)*')
+
+HEADER = 'Generated by tools/gen_layers.py from %s, do not edit.' % SPEC
+BEGIN = '// BEGIN GENERATED %s, edit ' + SPEC + ' and run tools/gen_layers.py\n'
+END = '// END GENERATED %s\n'
+
+# layer_table_keys flags
+KEY_LEFT = 0x01
+KEY_RIGHT = 0x02
+KEY_THUMB = 0x04
+
+
+class Board:
+    """One board's layout arguments, each a (layer name -> keycode) map plus
+    the position flags, in the order the LAYOUT macro takes them."""
+
+    def __init__(self, name, spec, layers, aliases):
+        self.name = name
+        self.keymap = os.path.join(ROOT, spec['keymap'])
+        self.layout = spec['layout']
+        self.keyboard = spec.get('keyboard')
+        self.aliases = aliases
+        self.layer_names = [layer['name'] for layer in layers]
+
+        # Shape rows as lists of (source, flags), source is (row, col) for
+        # a shared key or None for the next board key
+        self.shape = []
+        for text in spec['shape']:
+            tokens = text.split()
+            thumbs = not any(token[0] in 'LR' for token in tokens)
+            row = []
+            for token in tokens:
+                if token in ('<', '>'):
+                    flags = KEY_LEFT if token == '<' else KEY_RIGHT
+                    row.append((None, flags | (KEY_THUMB if thumbs else 0)))
+                elif re.fullmatch(r'[LR][0-9]', token) and int(token[1]) < CORE_ROWS:
+                    half = CORE_COLS // 2
+                    first = 0 if token[0] == 'L' else half
+                    flags = KEY_LEFT if token[0] == 'L' else KEY_RIGHT
+                    row += [((int(token[1]), col), flags) for col in range(first, first + half)]
+                else:
+                    raise SystemExit('%s: bad shape token %r' % (name, token))
+            self.shape.append(row)
+        board_slots = sum(source is None for row in self.shape for source, _ in row)
+
+        self.keys = {}
+        for layer in layers:
+            rows = [row.split() for row in layer['rows']]
+            if len(rows) != CORE_ROWS or any(len(row) != CORE_COLS for row in rows):
+                raise SystemExit('%s: needs %d rows of %d keys' % (layer['name'], CORE_ROWS, CORE_COLS))
+
+            own = layer.get(name, {})
+            for position, key in own.get('replace', {}).items():
+                row, col = (int(n) for n in position.split(','))
+                rows[row][col] = key
+
+            extra = own.get('keys', '').split()
+            if len(extra) > board_slots:
+                raise SystemExit('%s: %d keys for %s, it has %d' % (layer['name'], len(extra), name, board_slots))
+            extra += ['_______'] * (board_slots - len(extra))
+
+            keys = []
+            for row in self.shape:
+                for source, _ in row:
+                    keys.append(extra.pop(0) if source is None else rows[source[0]][source[1]])
+            self.keys[layer['name']] = keys
+
+    def flags(self):
+        return [flags for row in self.shape for _, flags in row]
+
+    def lines(self, cells):
+        """Lays the layout arguments out in the board's shape, aligned per
+        column with the halves pushed apart."""
+        rows, index = [], 0
+        for row in self.shape:
+            left = sum(1 for _, flags in row if flags & KEY_LEFT)
+            shared = any(source is not None for source, _ in row)
+            rows.append((cells[index:index + left], cells[index + left:index + len(row)], shared))
+            index += len(row)
+
+        # Rows of shared keys line up on the outside edge, thumbs on the inside
+        left_width = max(len(left) for left, _, _ in rows)
+        right_width = max(len(right) for _, right, _ in rows)
+        lefts, rights = [], []
+        for left, right, shared in rows:
+            left_pad, right_pad = [''] * (left_width - len(left)), [''] * (right_width - len(right))
+            lefts.append(left + left_pad if shared else left_pad + left)
+            rights.append(right_pad + right if shared else right + right_pad)
+
+        def widths(grid, count):
+            return [max(len(row[i]) for row in grid) + 1 for i in range(count)]
+
+        left_widths, right_widths = widths(lefts, left_width), widths(rights, right_width)
+        out = []
+        for left, right in zip(lefts, rights):
+            text = ''.join(cell.ljust(width) for cell, width in zip(left, left_widths))
+            text += '    ' + ''.join(cell.ljust(width) for cell, width in zip(right, right_widths))
+            out.append(text.rstrip())
+        return out
+
+
+def layout_call(board, values, indent):
+    """LAYOUT(...) with one value per argument, values already formatted."""
+    cells = [value + ',' for value in values]
+    cells[-1] = values[-1]
+    body = '\n'.join(indent + '    ' + line for line in board.lines(cells))
+    return '%s(\n%s\n%s)' % (board.layout, body, indent)
+
+
+def keymap_defines(spec, board):
+    out = ['enum filbar_layers {']
+    for index, layer in enumerate(spec['layers']):
+        out.append('    %s%s,' % (layer['name'], ' = 0' if index == 0 else ''))
+    out += ['};', '', '#define DEFAULT_LAYER %s' % spec['default_layer'], '']
+
+    out.append('enum filbar_keycodes {')
+    width = max(len(name) for name, _ in spec['keycodes']) + 1
+    for index, (name, comment) in enumerate(spec['keycodes']):
+        last = index == len(spec['keycodes']) - 1
+        entry = name + (' = SAFE_RANGE' if index == 0 else '') + ('' if last else ',')
+        out.append(('    %-*s  // %s' % (width, entry, comment) if comment else '    ' + entry).rstrip())
+    out += ['};', '']
+
+    for group in spec['aliases']:
+        out.append('// ' + group['comment'])
+        for name in group['defines']:
+            out.append('#define %s %s' % (name, board.aliases[name]))
+        out.append('')
+    return '\n'.join(out)
+
+
+def keymap_array(board):
+    out = ['// clang-format off', 'const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {']
+    for index, name in enumerate(board.layer_names):
+        if index:
+            out.append('')
+        out.append('    [%s] = %s,' % (name, layout_call(board, board.keys[name], '    ')))
+    out += ['};', '// clang-format on', '']
+    return '\n'.join(out) + sparse_layers(board)
+
+
+def canonical(key):
+    return '_______' if key in TRANS else 'XXXXXXX' if key in NONE else key
+
+
+def sparse_layers(board):
+    """Each layer's keys that differ from its fill key, packed in layout
+    order, and the per-layer bitmaps that find them."""
+    words = (len(board.flags()) + SPARSE_WORD - 1) // SPARSE_WORD
+    packed, layers = [], []
+    count = 0
+    for name in board.layer_names:
+        keys = [canonical(key) for key in board.keys[name]]
+        fill = max(sorted(set(keys)), key=keys.count)
+        live = [(index, key) for index, key in enumerate(keys) if key != fill]
+
+        present = [0] * words
+        for index, _ in live:
+            present[index // SPARSE_WORD] |= 1 << (index % SPARSE_WORD)
+        offsets = [count + sum(1 for index, _ in live if index < word * SPARSE_WORD) for word in range(words)]
+        count += len(live)
+
+        packed.append('    // %s, %d keys' % (name, len(live)))
+        for start in range(0, len(live), 8):
+            packed.append('    ' + ' '.join(key + ',' for _, key in live[start:start + 8]))
+        layers.append('    %-*s = {.present = {%s}, .offset = {%s}, .fill = %s},' % (
+            max(len(n) for n in board.layer_names) + 2, '[%s]' % name, ', '.join('0x%08X' % word for word in present), ', '.join('%3d' % n for n in offsets), fill))
+
+    out = ['', '// Sparse copy of keymaps[] for features/sparse_keymap.c, %d of %d keys' % (
+        count, len(board.flags()) * len(board.layer_names))]
+    out += ['// clang-format off', 'const uint16_t PROGMEM layer_sparse_keycodes[] = {'] + packed + ['};', '']
+    out += ['const layer_sparse_t PROGMEM layer_sparse[LAYER_TABLE_COUNT] = {'] + layers + ['};', '// clang-format on', '']
+    return '\n'.join(out)
+
+
+def leader_trie(spec, board):
+    """The leader sequences as nodes in breadth-first order, each node's
+    children next to each other in key order, see features/leader_trie.h."""
+    root = {'children': {}, 'action': None, 'keys': []}
+    for keys, action in spec.get('leader', []):
+        expanded = action
+        while expanded in board.aliases:
+            expanded = board.aliases[expanded]
+        if not ACTION.fullmatch(expanded):
+            raise SystemExit('leader %s: %s is not a keycode tap_code16() can send' % (keys, action))
+
+        node = root
+        for key in keys.split():
+            if key not in LEADER_KEYS:
+                raise SystemExit('leader %s: %s is not one of KC_A to KC_SLSH' % (keys, key))
+            node = node['children'].setdefault(LEADER_KEYS.index(key), {
+                'children': {}, 'action': None, 'keys': node['keys'] + [key]})
+        if node['action']:
+            raise SystemExit('leader %s: defined twice' % keys)
+        node['action'] = action
+
+    words = (len(LEADER_KEYS) + SPARSE_WORD - 1) // SPARSE_WORD
+    nodes, queue = [], [root]
+    while queue:
+        node = queue.pop(0)
+        node['index'] = len(nodes)
+        nodes.append(node)
+        queue += [node['children'][symbol] for symbol in sorted(node['children'])]
+
+    entries = []
+    for node in nodes:
+        children, offsets = [0] * words, []
+        for symbol in node['children']:
+            children[symbol // SPARSE_WORD] |= 1 << (symbol % SPARSE_WORD)
+        first = min((child['index'] for child in node['children'].values()), default=0)
+        for word in range(words):
+            offsets.append(first + sum(1 for symbol in node['children'] if symbol < word * SPARSE_WORD))
+        entries.append(('{.children = {%s}, .offset = {%s}, .action = %s},' % (
+            ', '.join('0x%08X' % bits for bits in children), ', '.join('%2d' % n for n in offsets),
+            node['action'] or 'KC_NO'), ' '.join(node['keys']) or 'LDR'))
+
+    width = max(len(entry) for entry, _ in entries)
+    out = ['#ifdef LEADER_TRIE_ENABLE', '// clang-format off', 'const leader_trie_node_t PROGMEM leader_trie[] = {']
+    out += ['    %-*s // %s' % (width, entry, keys) for entry, keys in entries]
+    out += ['};', '// clang-format on', '#endif // LEADER_TRIE_ENABLE', '']
+    return '\n'.join(out)
+
+
+def position_combos(spec, board):
+    """Each combo's keys as a bitmap of layout positions, and for each
+    position the combos it is in, see features/position_combo.h."""
+    slots = {}
+    for index, (source, _) in enumerate(source for row in board.shape for source in row):
+        if source is not None:
+            slots['%d,%d' % source] = index
+
+    combos = []
+    for keys, action in spec.get('combos', []):
+        expanded = action
+        while expanded in board.aliases:
+            expanded = board.aliases[expanded]
+        if not ACTION.fullmatch(expanded):
+            raise SystemExit('combo %s: %s is not a keycode register_code16() can send' % (keys, action))
+        positions = keys.split()
+        if not 2 <= len(positions) <= COMBO_KEYS or len(set(positions)) != len(positions):
+            raise SystemExit('combo %s: needs 2 to %d different keys' % (keys, COMBO_KEYS))
+        for position in positions:
+            if position not in slots:
+                raise SystemExit('combo %s: %s is not a shared key' % (keys, position))
+        combos.append((sum(1 << slots[position] for position in positions), action, keys))
+    if len(combos) > 32:
+        raise SystemExit('%d combos, position_combo_mask_t holds 32' % len(combos))
+    if len(board.flags()) > 64:
+        raise SystemExit('%s: %d keys, position_combo_keys_t holds 64' % (board.name, len(board.flags())))
+
+    index = [sum(1 << number for number, (keys, _, _) in enumerate(combos) if keys >> slot & 1)
+             for slot in range(len(board.flags()))]
+
+    width = max(len(action) for _, action, _ in combos)
+    out = ['#ifdef POSITION_COMBO_ENABLE', '// clang-format off',
+           'const position_combo_t PROGMEM position_combos[] = {']
+    out += ['    {.keys = 0x%016XULL, .action = %-*s}, // %s' % (keys, width, action, positions)
+            for keys, action, positions in combos]
+    out += ['};', '', '// Combos each key is in, in layout order',
+            'const position_combo_mask_t PROGMEM position_combo_index[LAYER_TABLE_KEYS] = {']
+    out += ['    ' + line for line in board.lines(['0x%02X,' % mask for mask in index])]
+    out += ['};', '// clang-format on', '#endif // POSITION_COMBO_ENABLE', '']
+    return '\n'.join(out)
+
+
+def text_expand(spec):
+    """The abbreviations as a DFA over a word boundary (symbol 0) and a to z
+    (1 to 26), see features/text_expand.h.  Each pattern is the abbreviation
+    between two boundaries, so a state matches at most one of them."""
+    patterns = []
+    for word, text in spec.get('expand', []):
+        if not re.fullmatch('[a-z]+', word):
+            raise SystemExit('expand %r: abbreviations are a to z only' % word)
+        if not text.isascii() or '\\' in text or '"' in text:
+            raise SystemExit('expand %r: the text must be plain ASCII without quotes' % word)
+        patterns.append([0] + [ord(c) - ord('a') + 1 for c in word] + [0])
+
+    symbols = 27
+    goto, depth, label, match = [{}], [0], [''], [0]
+    for number, pattern in enumerate(patterns):
+        state = 0
+        for symbol in pattern:
+            if symbol not in goto[state]:
+                goto.append({})
+                depth.append(depth[state] + 1)
+                label.append(label[state] + (' ' if symbol == 0 else chr(ord('a') + symbol - 1)))
+                match.append(0)
+                goto[state][symbol] = len(goto) - 1
+            state = goto[state][symbol]
+        if match[state]:
+            raise SystemExit('expand %r: defined twice' % spec['expand'][number][0])
+        match[state] = number + 1
+    if len(goto) > 255:
+        raise SystemExit('expand: %d states, the table holds 255' % len(goto))
+
+    # Breadth-first, so a state's failure link is resolved before its children
+    fail, delta, queue = [0] * len(goto), [None] * len(goto), [0]
+    while queue:
+        state = queue.pop(0)
+        delta[state] = [goto[state].get(symbol, delta[fail[state]][symbol] if state else 0) for symbol in range(symbols)]
+        for symbol, child in goto[state].items():
+            fail[child] = delta[fail[state]][symbol] if state else 0
+            queue.append(child)
+
+    text, offsets = [], []
+    for _, replacement in spec.get('expand', []):
+        offsets.append(sum(len(t) + 1 for t in text))
+        text.append(replacement)
+
+    width = max(len(str(n)) for row in delta for n in row)
+    out = ['#ifdef TEXT_EXPAND_ENABLE', '// clang-format off',
+           '// Next state by symbol: a word boundary, then a to z',
+           'const uint8_t PROGMEM text_expand_next[][TEXT_EXPAND_SYMBOLS] = {']
+    for state in range(len(goto)):
+        out.append('    {%s}, // "%s"' % (', '.join('%*d' % (width, n) for n in delta[state]), label[state]))
+    out += ['};', '', '// The expansion a state completes, plus one',
+            'const uint8_t PROGMEM text_expand_match[] = {']
+    for start in range(0, len(match), 16):
+        out.append('    ' + ' '.join('%d,' % n for n in match[start:start + 16]))
+    out += ['};', '', 'const text_expand_t PROGMEM text_expand_words[] = {']
+    for (word, replacement), offset in zip(spec.get('expand', []), offsets):
+        out.append('    {.text = %3d, .typed = %d}, // %s' % (offset, len(word), word))
+    out += ['};', '', 'const char PROGMEM text_expand_text[] =']
+    out += ['    "%s\\0"' % replacement for replacement in text[:-1]] + ['    "%s";' % text[-1]]
+    out += ['// clang-format on', '#endif // TEXT_EXPAND_ENABLE', '']
+    return '\n'.join(out)
+
+
+def replace_region(src, region, body, path):
+    begin, end = BEGIN % region, END % region
+    if begin not in src or end not in src:
+        raise SystemExit('%s: no %r / %r markers' % (path, begin.strip(), end.strip()))
+    head, rest = src.split(begin, 1)
+    _, tail = rest.split(end, 1)
+    return head + begin + body + end + tail
+
+
+def layer_mask(board, predicate):
+    layers = len(board.layer_names)
+    masks = [0] * len(board.flags())
+    for index, name in enumerate(board.layer_names):
+        for position, key in enumerate(board.keys[name]):
+            if predicate(key):
+                masks[position] |= 1 << index
+    return ['0x%0*X' % ((layers + 3) // 4, mask) for mask in masks]
+
+
+def layer_tables(spec, board):
+    count = len(board.layer_names)
+    if len(board.flags()) > 255:
+        raise SystemExit('%s: %d keys, layer_table_slots holds 255' % (board.name, len(board.flags())))
+    if count > 32:
+        raise SystemExit('%d layers, QMK has 32 at most' % count)
+    kind = 'uint8_t' if count <= 8 else 'uint16_t' if count <= 16 else 'uint32_t'
+    typing = sum(1 << i for i, layer in enumerate(spec['layers']) if layer.get('typing'))
+
+    header = '''// %s
+//
+// Constant per-key tables for the %s layers, in matrix order like
+// keymaps[].  A layer_table_t holds one bit per layer, bit n for layer n.
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+#define LAYER_TABLE_COUNT %d
+
+// Layers text is typed on, the base layer and the default layers
+#define LAYER_TABLE_TYPING 0x%0*X
+
+typedef %s layer_table_t;
+
+// layer_table_keys flags, 0 where the matrix has no key
+#define LAYER_TABLE_KEY_LEFT 0x%02X
+#define LAYER_TABLE_KEY_RIGHT 0x%02X
+#define LAYER_TABLE_KEY_THUMB 0x%02X
+
+// Layers the key is bound on, anything but KC_TRNS
+extern const layer_table_t layer_table_bound[MATRIX_ROWS][MATRIX_COLS];
+
+// Layers the key is a mod-tap or layer-tap on
+extern const layer_table_t layer_table_tap_hold[MATRIX_ROWS][MATRIX_COLS];
+
+// Hand and cluster of the key
+extern const uint8_t layer_table_keys[MATRIX_ROWS][MATRIX_COLS];
+
+// Indicator colour of each layer
+extern const HSV layer_table_colours[LAYER_TABLE_COUNT];
+
+// Keys in the layout and the words of a layer_sparse_t bitmap
+#define LAYER_TABLE_KEYS %d
+#define LAYER_TABLE_WORDS %d
+
+// Position of the key in the layout plus one, 0 where the matrix has no key
+extern const uint8_t layer_table_slots[MATRIX_ROWS][MATRIX_COLS];
+
+// One layer of the sparse keymap: bit n of present is set when layout key n
+// is stored, in layer_sparse_keycodes from offset[n / 32] on, and clear when
+// it is fill
+typedef struct {
+    uint32_t present[LAYER_TABLE_WORDS];
+    uint16_t offset[LAYER_TABLE_WORDS];
+    uint16_t fill;
+} layer_sparse_t;
+
+// Both in keymap.c, next to keymaps[]
+extern const uint16_t       layer_sparse_keycodes[];
+extern const layer_sparse_t layer_sparse[LAYER_TABLE_COUNT];
+''' % (HEADER, board.name, count, (count + 3) // 4, typing, kind, KEY_LEFT, KEY_RIGHT, KEY_THUMB,
+       len(board.flags()), (len(board.flags()) + SPARSE_WORD - 1) // SPARSE_WORD)
+
+    layers = {name: index for index, name in enumerate(board.layer_names)}
+
+    def tap_hold(key):
+        return latency_model.parse_key(key, board.aliases, layers).tap_hold
+
+    entries = ['[%d] = {%s},' % (index, layer.get('colour', 'HSV_OFF')) for index, layer in enumerate(spec['layers'])]
+    width = max(len(entry) for entry in entries) + 1
+    colours = ['    %-*s // %s' % (width, entry, layer['name']) for entry, layer in zip(entries, spec['layers'])]
+
+    source = '''// %s
+#include "layer_tables.h"
+
+// clang-format off
+const layer_table_t layer_table_bound[MATRIX_ROWS][MATRIX_COLS] = %s;
+
+const layer_table_t layer_table_tap_hold[MATRIX_ROWS][MATRIX_COLS] = %s;
+
+const uint8_t layer_table_keys[MATRIX_ROWS][MATRIX_COLS] = %s;
+
+const uint8_t layer_table_slots[MATRIX_ROWS][MATRIX_COLS] = %s;
+// clang-format on
+
+const HSV layer_table_colours[LAYER_TABLE_COUNT] = {
+%s
+};
+''' % (HEADER,
+       layout_call(board, layer_mask(board, lambda key: key not in TRANS), ''),
+       layout_call(board, layer_mask(board, tap_hold), ''),
+       layout_call(board, ['0x%02X' % flags for flags in board.flags()], ''),
+       layout_call(board, [str(index + 1) for index in range(len(board.flags()))], ''),
+       '\n'.join(colours))
+    return header, source
+
+
+def heatmap_params(board):
+    """HEATMAP_* as features/heatmap.h defaults them and the keymap's
+    config.h overrides them."""
+    params = {}
+    for path in (os.path.join(ROOT, 'users/filbar/features/heatmap.h'), os.path.join(board.keymap, 'config.h')):
+        defines = latency_model.parse_defines(latency_model.strip_comments(open(path).read()))
+        params.update({name: int(value, 0) for name, value in defines.items() if name.startswith('HEATMAP_')})
+    return params
+
+
+def heat_tables(board):
+    """The heatmap neighbour lists, as _build_tables() in
+    features/heatmap.c works them out from g_led_config."""
+    info = latency_model.load_json(os.path.join(ROOT, board.keyboard))
+    leds = info['rgb_matrix']['layout']
+    params = heatmap_params(board)
+    spread, limit, most = params['HEATMAP_SPREAD'], params['HEATMAP_AREA_LIMIT'], params['HEATMAP_MAX_NEIGHBOURS']
+
+    keys = [index for index, led in enumerate(leds) if 'matrix' in led]
+    lists = []
+    for led in range(len(leds)):
+        neighbours = []
+        for other in keys if led in keys else []:
+            if other == led:
+                continue
+            dx = leds[led]['x'] - leds[other]['x']
+            dy = leds[led]['y'] - leds[other]['y']
+            # sqrt16() takes a uint16_t and returns a uint8_t
+            distance = min(math.isqrt((dx * dx + dy * dy) & 0xFFFF), 255)
+            if distance > spread:
+                continue
+            weight = min(spread - distance, limit)
+            # Closest first, later ones after earlier ones of the same weight
+            if len(neighbours) == most:
+                if weight <= neighbours[-1][1]:
+                    continue
+                neighbours.pop()
+            at = len(neighbours)
+            while at > 0 and neighbours[at - 1][1] < weight:
+                at -= 1
+            neighbours.insert(at, (other, weight))
+        lists.append(neighbours)
+
+    header = '''
+#ifdef RGB_MATRIX_ENABLE
+// Typing heatmap neighbours of each key LED for features/heatmap.c, closest
+// first, worked out from the LED layout in
+// %s
+// with these settings
+#define LAYER_TABLE_HEAT_LEDS %d
+#define LAYER_TABLE_HEAT_SPREAD %d
+#define LAYER_TABLE_HEAT_AREA_LIMIT %d
+#define LAYER_TABLE_HEAT_NEIGHBOURS %d
+
+typedef struct {
+    uint8_t led;
+    uint8_t weight;
+} layer_table_heat_t;
+
+extern const layer_table_heat_t layer_table_heat[LAYER_TABLE_HEAT_LEDS][LAYER_TABLE_HEAT_NEIGHBOURS];
+extern const uint8_t            layer_table_heat_count[LAYER_TABLE_HEAT_LEDS];
+#endif // RGB_MATRIX_ENABLE
+''' % (board.keyboard, len(leds), spread, limit, most)
+
+    rows = ['    {%s}, // %d' % (', '.join('{%d, %d}' % n for n in neighbours), led) for led, neighbours in enumerate(lists)]
+    counts = [str(len(neighbours)) for neighbours in lists]
+    source = '''
+#ifdef RGB_MATRIX_ENABLE
+// clang-format off
+const layer_table_heat_t layer_table_heat[LAYER_TABLE_HEAT_LEDS][LAYER_TABLE_HEAT_NEIGHBOURS] = {
+%s
+};
+
+const uint8_t layer_table_heat_count[LAYER_TABLE_HEAT_LEDS] = {
+%s
+};
+// clang-format on
+#endif // RGB_MATRIX_ENABLE
+''' % ('\n'.join(rows).replace('{}', '{{0, 0}}'), '\n'.join('    ' + ', '.join(counts[i:i + 16]) + ',' for i in range(0, len(counts), 16)))
+    return header, source
+
+
+def generate(spec, name):
+    aliases = {}
+    for group in spec['aliases']:
+        aliases.update(group['defines'])
+    aliases.update(spec['boards'][name].get('aliases', {}))
+    board = Board(name, spec['boards'][name], spec['layers'], aliases)
+
+    keymap_path = os.path.join(board.keymap, 'keymap.c')
+    src = open(keymap_path).read()
+    src = replace_region(src, 'layers', keymap_defines(spec, board), keymap_path)
+    src = replace_region(src, 'keymaps', keymap_array(board), keymap_path)
+    src = replace_region(src, 'leader', leader_trie(spec, board), keymap_path)
+    src = replace_region(src, 'combos', position_combos(spec, board), keymap_path)
+    src = replace_region(src, 'expand', text_expand(spec), keymap_path)
+
+    header, source = layer_tables(spec, board)
+    if board.keyboard:
+        heat_header, heat_source = heat_tables(board)
+        header += heat_header
+        source += heat_source
+    return {
+        keymap_path: src,
+        os.path.join(board.keymap, 'layer_tables.h'): header,
+        os.path.join(board.keymap, 'layer_tables.c'): source,
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('boards', nargs='*', help='boards to generate (default: all in the spec)')
+    parser.add_argument('--spec', default=os.path.join(ROOT, SPEC), help='layer definition')
+    parser.add_argument('--check', action='store_true', help='only report files that are out of date')
+    args = parser.parse_args()
+
+    spec = latency_model.load_json(args.spec)
+    stale = []
+    for name in args.boards or spec['boards']:
+        if name not in spec['boards']:
+            raise SystemExit('no board %r in %s' % (name, args.spec))
+        for path, text in generate(spec, name).items():
+            current = open(path).read() if os.path.exists(path) else None
+            if current == text:
+                continue
+            stale.append(os.path.relpath(path, ROOT))
+            if not args.check:
+                with open(path, 'w') as out:
+                    out.write(text)
+
+    for path in stale:
+        print(('stale: ' if args.check else 'wrote ') + path)
+    return 1 if args.check and stale else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
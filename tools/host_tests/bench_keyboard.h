@@ -0,0 +1,7 @@
+// The stand-in QMK in tools/rgb_bench/qmk wants a keyboard, the host tests
+// do not need one
+#pragma once
+
+#define MATRIX_ROWS 1
+#define MATRIX_COLS 1
+#define RGB_MATRIX_LED_COUNT 1
@@ -0,0 +1,209 @@
+// Correctness test for features/bulk_send.c, see Makefile.
+//
+// Types random strings with bulk_send_string(), some of them while the user
+// holds keys of their own, and replays every report through a model of the
+// host: modifiers first, then the keys that went up, then the new keys in
+// report order (usage order for NKRO).  The text the host saw has to be the
+// text that was sent, the held keys have to still be down and everything
+// else released afterwards.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "quantum.h"
+#include "features/bulk_send.h"
+
+#define RUNS 2000
+#define HELD_RUNS 500
+#define MAX_TEXT 400
+
+// Keys the user holds meanwhile, none of them type text
+#define HELD_BASE 0x3A // KC_F1
+
+// The keyboard's side: QMK's report and the calls bulk_send makes
+
+keymap_config_t keymap_config;
+
+static report_keyboard_t report;
+report_keyboard_t       *keyboard_report = &report;
+
+static uint8_t nkro_bits[32];
+static uint8_t weak_mods;
+static int     dropped;
+
+static bool nkro(void) {
+    return keymap_config.nkro;
+}
+
+void add_key(uint8_t key) {
+    if (nkro()) {
+        nkro_bits[key / 8] |= 1 << (key % 8);
+        return;
+    }
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (report.keys[i] == key) {
+            return;
+        }
+    }
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (!report.keys[i]) {
+            report.keys[i] = key;
+            return;
+        }
+    }
+    dropped++;
+}
+
+void del_key(uint8_t key) {
+    if (nkro()) {
+        nkro_bits[key / 8] &= ~(1 << (key % 8));
+        return;
+    }
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (report.keys[i] == key) {
+            report.keys[i] = 0;
+        }
+    }
+}
+
+void add_weak_mods(uint8_t mods) {
+    weak_mods |= mods;
+}
+
+void del_weak_mods(uint8_t mods) {
+    weak_mods &= ~mods;
+}
+
+// The host's side: the keys it has down and what it typed
+
+static bool    host_down[256];
+static char    typed[MAX_TEXT * 2];
+static int     typed_count;
+static int     reports;
+static bool    is_held[256];
+
+static char _char_for(uint8_t key, bool shifted) {
+    for (int ascii = 0; ascii < 128; ascii++) {
+        const bool ascii_shifted = ascii_to_shift_lut[ascii / 8] & (0x80 >> (ascii % 8));
+        if (ascii_to_keycode_lut[ascii] == key && ascii_shifted == shifted) {
+            return ascii;
+        }
+    }
+    return '?';
+}
+
+static void _host_press(uint8_t key, bool shifted) {
+    if (!host_down[key]) {
+        host_down[key] = true;
+        if (!is_held[key] && typed_count < (int)sizeof(typed) - 1) {
+            typed[typed_count++] = _char_for(key, shifted);
+        }
+    }
+}
+
+void send_keyboard_report(void) {
+    bool now_down[256] = {0};
+    if (nkro()) {
+        for (int key = 0; key < 256; key++) {
+            now_down[key] = nkro_bits[key / 8] & (1 << (key % 8));
+        }
+    } else {
+        for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+            now_down[report.keys[i]] = report.keys[i] != 0;
+        }
+    }
+
+    const bool shifted = weak_mods & MOD_BIT(KC_LEFT_SHIFT);
+    for (int key = 0; key < 256; key++) {
+        if (!now_down[key]) {
+            host_down[key] = false;
+        }
+    }
+    if (nkro()) {
+        for (int key = 0; key < 256; key++) {
+            if (now_down[key]) {
+                _host_press(key, shifted);
+            }
+        }
+    } else {
+        for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+            if (report.keys[i]) {
+                _host_press(report.keys[i], shifted);
+            }
+        }
+    }
+    reports++;
+}
+
+// The test
+
+static const char alphabet[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789 .,;:!?'\"()-_\n\t";
+
+static void _random_text(char *text) {
+    const int length = 1 + rand() % (MAX_TEXT - 1);
+    for (int i = 0; i < length; i++) {
+        // Plenty of doubled characters, they need a release in between
+        text[i] = i && rand() % 5 == 0 ? text[i - 1] : alphabet[rand() % (sizeof(alphabet) - 1)];
+    }
+    text[length] = 0;
+}
+
+static bool _run(const char *text, uint8_t held) {
+    for (uint8_t i = 0; i < held; i++) {
+        add_key(HELD_BASE + i);
+        is_held[HELD_BASE + i] = true;
+    }
+    send_keyboard_report();
+
+    typed_count = 0;
+    reports     = 0;
+    dropped     = 0;
+    bulk_send_string(text);
+    bulk_send_flush();
+    typed[typed_count] = 0;
+
+    bool ok = strcmp(typed, text) == 0 && !dropped && !weak_mods;
+    for (int key = 0; key < 256; key++) {
+        ok = ok && host_down[key] == (is_held[key] && key < HELD_BASE + held);
+    }
+    if (!ok) {
+        printf("FAIL with %u held keys, %d dropped\n  sent:  %s\n  typed: %s\n", held, dropped, text, typed);
+    }
+
+    for (uint8_t i = 0; i < held; i++) {
+        del_key(HELD_BASE + i);
+        is_held[HELD_BASE + i] = false;
+    }
+    send_keyboard_report();
+    return ok;
+}
+
+int main(void) {
+#ifdef NKRO_ENABLE
+    keymap_config.nkro = true;
+#endif
+    srand(1);
+
+    char text[MAX_TEXT];
+    long chars = 0, sent = 0;
+    for (int run = 0; run < RUNS; run++) {
+        _random_text(text);
+        if (!_run(text, 0)) {
+            return 1;
+        }
+        chars += strlen(text);
+        sent += reports;
+    }
+
+    // One to five keys held, 6KRO has a single slot left at the end
+    for (int run = 0; run < HELD_RUNS; run++) {
+        _random_text(text);
+        if (!_run(text, 1 + run % (KEYBOARD_REPORT_KEYS - 1))) {
+            return 1;
+        }
+    }
+
+    printf("bulk_send %s, %d keys per report: %d texts ok, %ld chars in %ld reports (send_string: %ld)\n",
+           nkro() ? "NKRO" : "6KRO", BULK_SEND_KEYS, RUNS + HELD_RUNS, chars, sent, 2 * chars);
+    return 0;
+}
@@ -0,0 +1,113 @@
+// Two-thread test for features/spsc.h, see Makefile.
+//
+// Two host threads stand in for the RP2040's cores.  The producer pushes a
+// numbered sequence through a small queue that is full most of the time,
+// and the consumer checks that every item comes out once, in order and
+// whole.  Then the two pass a pair of frame buffers back and forth through
+// two queues, the way features/core1.c hands frames between the cores: each
+// side writes a frame only while it owns it, so ThreadSanitizer (the
+// `spsc` target builds with -fsanitize=thread) reports any read of a frame
+// the other side is still writing.
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "features/spsc.h"
+
+#define ITEMS 1000000
+#define FRAMES 20000
+#define FRAME_SIZE 64
+
+typedef struct {
+    uint32_t seq;
+    uint32_t check; // ~seq, a torn item would not match
+} item_t;
+
+SPSC_QUEUE(item_queue, item_t, 8)
+SPSC_QUEUE(frame_queue, uint8_t, 2)
+
+static item_queue_t items;
+
+static void *_produce_items(void *arg) {
+    for (uint32_t seq = 0; seq < ITEMS; seq++) {
+        const item_t item = {seq, ~seq};
+        while (!item_queue_push(&items, &item)) {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static bool _consume_items(void) {
+    for (uint32_t seq = 0; seq < ITEMS; seq++) {
+        item_t item;
+        while (!item_queue_pop(&items, &item)) {
+            sched_yield();
+        }
+        if (item.seq != seq || item.check != ~seq) {
+            printf("FAIL: item %u came out as %u/%08x\n", seq, item.seq, item.check);
+            return false;
+        }
+    }
+    return true;
+}
+
+// Frames the renderer may fill, and frames ready to be shown
+static frame_queue_t free_frames;
+static frame_queue_t ready_frames;
+static uint8_t       frames[2][FRAME_SIZE];
+
+static void *_render_frames(void *arg) {
+    for (uint32_t n = 0; n < FRAMES; n++) {
+        uint8_t frame;
+        while (!frame_queue_pop(&free_frames, &frame)) {
+            sched_yield();
+        }
+        for (uint8_t i = 0; i < FRAME_SIZE; i++) {
+            frames[frame][i] = (uint8_t)(n + i);
+        }
+        while (!frame_queue_push(&ready_frames, &frame)) {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static bool _show_frames(void) {
+    for (uint8_t frame = 0; frame < 2; frame++) {
+        frame_queue_push(&free_frames, &frame);
+    }
+    for (uint32_t n = 0; n < FRAMES; n++) {
+        uint8_t frame;
+        while (!frame_queue_pop(&ready_frames, &frame)) {
+            sched_yield();
+        }
+        for (uint8_t i = 0; i < FRAME_SIZE; i++) {
+            if (frames[frame][i] != (uint8_t)(n + i)) {
+                printf("FAIL: frame %u byte %u is %u\n", n, i, frames[frame][i]);
+                return false;
+            }
+        }
+        frame_queue_push(&free_frames, &frame);
+    }
+    return true;
+}
+
+int main(void) {
+    pthread_t producer;
+    pthread_create(&producer, NULL, _produce_items, NULL);
+    const bool items_ok = _consume_items();
+    pthread_join(producer, NULL);
+
+    pthread_t renderer;
+    pthread_create(&renderer, NULL, _render_frames, NULL);
+    const bool frames_ok = _show_frames();
+    pthread_join(renderer, NULL);
+
+    if (!items_ok || !frames_ok) {
+        return 1;
+    }
+    printf("spsc: %d items and %d frames passed between two threads\n", ITEMS, FRAMES);
+    return 0;
+}
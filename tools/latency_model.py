@@ -0,0 +1,745 @@
+#!/usr/bin/env python3
+"""Tap-hold and auto shift timing model for the filbar keymaps.
+
+Replays a recorded key trace through a model of the decisions QMK makes for
+the keymap (mod-taps, layer-taps, PERMISSIVE_HOLD, auto shift, retro shift,
+one-shot modifiers, momentary layers and layer lock) under one or more timing
+configurations,
+and reports for each:
+
+  * added output latency per keystroke (from the physical press to the
+    moment the keystroke produced its character)
+  * how many keys resolved as holds and auto shifts
+  * with --expect, the misfires (holds and shifts that were not meant, found
+    by aligning the output with the text that was meant to be typed) and the
+    edit distance to it
+
+so TAPPING_TERM, AUTO_SHIFT_TIMEOUT and friends can be picked from data.
+
+Record a trace with KEY_TRACE_ENABLE = yes and CONSOLE_ENABLE = yes, type
+something, and keep the console output:
+
+    qmk console | tee trace.log
+
+The TRACE: lines carry matrix positions, --info maps them onto the keymap
+(the keyboard.json / info.json of the board, or `qmk info -f json` output).
+Traces can also be written by hand as `<ms> <layout index> <1|0>` lines.
+
+    tools/latency_model.py keyboards/bastardkb/scylla/keymaps/filbar-scylla \\
+        trace.log --info scylla.json --expect meant.txt \\
+        --config fast:tapping_term=170 --sweep auto_shift_timeout=175:275:25
+
+The keymap's own config.h is always the first configuration.  This is a
+model: it follows QMK's rules for the features the keymaps use, not every
+corner of action_tapping.c.
+"""
+
+import argparse
+import collections
+import dataclasses
+import difflib
+import json
+import math
+import os
+import re
+import statistics
+import sys
+
+# --------------------------------------------------------------------------
+# Keycodes
+
+MOD_NAMES = {
+    'LCTL': 'C', 'LCTRL': 'C', 'RCTL': 'C', 'RCTRL': 'C',
+    'LSFT': 'S', 'LSHIFT': 'S', 'RSFT': 'S', 'RSHIFT': 'S',
+    'LALT': 'A', 'LOPT': 'A', 'RALT': 'A', 'ROPT': 'A', 'ALGR': 'A',
+    'LGUI': 'G', 'LCMD': 'G', 'LWIN': 'G', 'RGUI': 'G', 'RCMD': 'G', 'RWIN': 'G',
+}
+MOD_WRAPPERS = {'C': 'C', 'S': 'S', 'A': 'A', 'G': 'G', 'LCTL': 'C', 'LSFT': 'S', 'LALT': 'A', 'LGUI': 'G',
+                'RCTL': 'C', 'RSFT': 'S', 'RALT': 'A', 'RGUI': 'G', 'LCMD': 'G', 'LOPT': 'A'}
+
+CHARS = {
+    'SPC': (' ', ' '), 'SPACE': (' ', ' '), 'ENT': ('\n', '\n'), 'ENTER': ('\n', '\n'), 'TAB': ('\t', '\t'),
+    'MINS': ('-', '_'), 'MINUS': ('-', '_'), 'EQL': ('=', '+'), 'EQUAL': ('=', '+'),
+    'LBRC': ('[', '{'), 'RBRC': (']', '}'), 'BSLS': ('\\', '|'), 'SCLN': (';', ':'),
+    'QUOT': ("'", '"'), 'GRV': ('`', '~'), 'COMM': (',', '<'), 'DOT': ('.', '>'), 'SLSH': ('/', '?'),
+    '1': ('1', '!'), '2': ('2', '@'), '3': ('3', '#'), '4': ('4', '$'), '5': ('5', '%'),
+    '6': ('6', '^'), '7': ('7', '&'), '8': ('8', '*'), '9': ('9', '('), '0': ('0', ')'),
+}
+for letter in 'ABCDEFGHIJKLMNOPQRSTUVWXYZ':
+    CHARS[letter] = (letter.lower(), letter)
+
+# Shifted aliases, KC_LT is S(KC_COMM) and so on
+SHIFTED = {
+    'LT': 'COMM', 'GT': 'DOT', 'LCBR': 'LBRC', 'RCBR': 'RBRC', 'LPRN': '9', 'RPRN': '0',
+    'ASTR': '8', 'PLUS': 'EQL', 'UNDS': 'MINS', 'COLN': 'SCLN', 'DQUO': 'QUOT', 'PIPE': 'BSLS',
+    'TILD': 'GRV', 'EXLM': '1', 'AT': '2', 'HASH': '3', 'DLR': '4', 'PERC': '5', 'CIRC': '6',
+    'AMPR': '7', 'QUES': 'SLSH',
+}
+
+# Custom keycodes handled by update_oneshot() in the keymaps: trigger -> mod
+ONESHOTS = {'OS_SHFT': 'S', 'OS_CTRL': 'C', 'OS_ALT': 'A', 'OS_CMD': 'G'}
+
+# What AUTO_SHIFT shifts by default: alphas, numbers, tab and symbols
+AUTO_SHIFTED = set('ABCDEFGHIJKLMNOPQRSTUVWXYZ1234567890') | {
+    'TAB', 'MINS', 'MINUS', 'EQL', 'EQUAL', 'LBRC', 'RBRC', 'BSLS', 'SCLN', 'QUOT', 'GRV', 'COMM', 'DOT', 'SLSH'}
+
+
+@dataclasses.dataclass
+class Key:
+    kind: str              # plain, mod, mod_tap, layer_tap, momentary, lock, oneshot, trans, none, other
+    name: str              # base KC_ name without the prefix, or the raw token
+    mods: frozenset = frozenset()       # sent with the key, S(KC_1) and friends
+    hold_mods: frozenset = frozenset()  # mod-tap hold, one-shot modifier
+    layer: int = 0
+
+    @property
+    def tap_hold(self):
+        return self.kind in ('mod_tap', 'layer_tap')
+
+    def char(self, shifted):
+        if self.name not in CHARS:
+            return None
+        return CHARS[self.name][1 if shifted else 0]
+
+
+def split_args(text):
+    args, depth, current = [], 0, ''
+    for ch in text:
+        if ch == '(':
+            depth += 1
+        elif ch == ')':
+            depth -= 1
+        if ch == ',' and depth == 0:
+            args.append(current.strip())
+            current = ''
+        else:
+            current += ch
+    if current.strip():
+        args.append(current.strip())
+    return args
+
+
+def parse_key(token, defines, layers):
+    token = token.strip()
+    for _ in range(10):
+        if token in defines:
+            token = defines[token].strip()
+
+    def layer_index(name):
+        name = name.strip()
+        name = defines.get(name, name)
+        return layers[name] if name in layers else int(name, 0)
+
+    if token in ('_______', 'KC_TRNS', 'KC_TRANSPARENT'):
+        return Key('trans', token)
+    if token in ('XXXXXXX', 'KC_NO'):
+        return Key('none', token)
+    if token == 'LLOCK':
+        return Key('lock', token)
+    if token in ONESHOTS:
+        return Key('oneshot', token, hold_mods=frozenset({ONESHOTS[token]}))
+
+    call = re.fullmatch(r'(\w+)\((.*)\)', token, re.S)
+    if call:
+        fn, args = call[1], split_args(call[2])
+        if fn == 'LT':
+            inner = parse_key(args[1], defines, layers)
+            return Key('layer_tap', inner.name, inner.mods, layer=layer_index(args[0]))
+        if fn == 'MO':
+            return Key('momentary', token, layer=layer_index(args[0]))
+        if fn.endswith('_T') and fn[:-2] in MOD_NAMES:
+            inner = parse_key(args[0], defines, layers)
+            return Key('mod_tap', inner.name, inner.mods, frozenset({MOD_NAMES[fn[:-2]]}))
+        if fn == 'MT':
+            mods = frozenset(MOD_NAMES[m] for m in re.findall(r'MOD_(\w+)', args[0]) if m in MOD_NAMES)
+            inner = parse_key(args[1], defines, layers)
+            return Key('mod_tap', inner.name, inner.mods, mods)
+        if fn in MOD_WRAPPERS:
+            inner = parse_key(args[0], defines, layers)
+            return dataclasses.replace(inner, mods=inner.mods | {MOD_WRAPPERS[fn]})
+        return Key('other', token)
+
+    if token.startswith('KC_'):
+        name = token[3:]
+        if name in MOD_NAMES:
+            return Key('mod', name, frozenset({MOD_NAMES[name]}))
+        if name in SHIFTED:
+            return Key('plain', SHIFTED[name], frozenset({'S'}))
+        return Key('plain', name)
+    if token == 'QK_GESC':
+        return Key('plain', 'ESC')
+    return Key('other', token)
+
+
+def strip_comments(src):
+    src = re.sub(r'/\*.*?\*/', '', src, flags=re.S)
+    return re.sub(r'//[^\n]*', '', src)
+
+
+def parse_defines(src):
+    defines = {}
+    for match in re.finditer(r'^[ \t]*#[ \t]*define[ \t]+(\w+)[ \t]+([^\n]+)$', src, re.M):
+        defines[match[1]] = match[2].strip()
+    return defines
+
+
+def parse_layers(src):
+    for body in re.findall(r'enum\s+\w*\s*\{([^}]*)\}', src):
+        names = [n.split('=')[0].strip() for n in body.split(',') if n.strip()]
+        if '_BASE' in names:
+            layers, index = {}, 0
+            for entry in body.split(','):
+                if not entry.strip():
+                    continue
+                name, _, value = entry.partition('=')
+                index = int(value, 0) if value.strip() else index
+                layers[name.strip()] = index
+                index += 1
+            return layers
+    raise SystemExit('no layer enum with _BASE in the keymap')
+
+
+@dataclasses.dataclass
+class Keymap:
+    layout: str
+    layers: list          # layer index -> list of Key in layout order
+    default_layer: int
+    names: dict
+
+
+def parse_keymap(keymap_dir):
+    src = strip_comments(open(os.path.join(keymap_dir, 'keymap.c')).read())
+    defines = parse_defines(src)
+    layers = parse_layers(src)
+
+    body = re.search(r'keymaps\s*\[\]\s*\[MATRIX_ROWS\]\s*\[MATRIX_COLS\]\s*=\s*\{(.*)\n\};', src, re.S)
+    if not body:
+        raise SystemExit('no keymaps[] array in the keymap')
+
+    table, layout = {}, None
+    for match in re.finditer(r'\[(\w+)\]\s*=\s*(LAYOUT\w*)\(', body[1]):
+        layout = match[2]
+        depth, end = 1, match.end()
+        while depth:
+            depth += {'(': 1, ')': -1}.get(body[1][end], 0)
+            end += 1
+        args = split_args(body[1][match.end():end - 1])
+        table[layers[match[1]]] = [parse_key(arg, defines, layers) for arg in args]
+
+    count = max(table) + 1
+    size = len(next(iter(table.values())))
+    keys = [table.get(i, [Key('trans', '_______')] * size) for i in range(count)]
+    default = defines.get('DEFAULT_LAYER', '0')
+    default = layers[default] if default in layers else int(default, 0)
+    return Keymap(layout, keys, default, {v: k for k, v in layers.items()})
+
+
+# --------------------------------------------------------------------------
+# Timing configurations
+
+@dataclasses.dataclass
+class Config:
+    name: str
+    tapping_term: int = 200
+    permissive: bool = False
+    auto_shift: bool = False
+    auto_shift_timeout: int = 175
+    retro_shift: float = 0        # 0 off, math.inf for no limit
+
+    def describe(self):
+        retro = 'off' if not self.retro_shift else ('on' if math.isinf(self.retro_shift) else self.retro_shift)
+        return 'TT %d%s, AS %s, retro %s' % (
+            self.tapping_term, ' permissive' if self.permissive else '',
+            self.auto_shift_timeout if self.auto_shift else 'off', retro)
+
+
+def keymap_config(keymap_dir):
+    src = strip_comments(open(os.path.join(keymap_dir, 'config.h')).read())
+    defines = parse_defines(src + '\n')
+    flags = set(re.findall(r'^[ \t]*#[ \t]*define[ \t]+(\w+)[ \t]*$', src, re.M))
+
+    rules = open(os.path.join(keymap_dir, 'rules.mk')).read()
+    auto_shift = re.search(r'^AUTO_SHIFT_ENABLE\s*=\s*yes', rules, re.M) is not None
+
+    def number(name, default):
+        return int(defines[name].split()[0], 0) if name in defines else default
+
+    retro = number('RETRO_SHIFT', 0) if 'RETRO_SHIFT' in defines else (math.inf if 'RETRO_SHIFT' in flags else 0)
+    return Config('keymap', number('TAPPING_TERM', 200), 'PERMISSIVE_HOLD' in flags, auto_shift,
+                  number('AUTO_SHIFT_TIMEOUT', 175), retro)
+
+
+def config_from_spec(base, spec):
+    name, _, settings = spec.partition(':')
+    config = dataclasses.replace(base, name=name)
+    for setting in filter(None, settings.split(',')):
+        key, _, value = setting.partition('=')
+        set_field(config, key.strip(), value.strip())
+    return config
+
+
+def set_field(config, key, value):
+    if key not in ('tapping_term', 'permissive', 'auto_shift', 'auto_shift_timeout', 'retro_shift'):
+        raise SystemExit('unknown setting %s' % key)
+    if key in ('permissive', 'auto_shift'):
+        setattr(config, key, value in ('1', 'yes', 'true', 'on'))
+    elif key == 'retro_shift' and value in ('on', 'inf'):
+        config.retro_shift = math.inf
+    else:
+        setattr(config, key, int(value))
+
+
+# --------------------------------------------------------------------------
+# Traces
+
+def load_json(path):
+    """QMK's keyboard.json files carry // comments, json does not."""
+    text, out, quoted, i = open(path).read(), [], False, 0
+    while i < len(text):
+        if text[i] == '"' and (i == 0 or text[i - 1] != '\\'):
+            quoted = not quoted
+        elif not quoted and text.startswith('//', i):
+            i = text.find('\n', i)
+            i = len(text) if i < 0 else i
+            continue
+        out.append(text[i])
+        i += 1
+    return json.loads(''.join(out))
+
+
+TRACE_RE = re.compile(r'TRACE: (\d+) (\d+) (\d+) ([01])')
+INDEX_RE = re.compile(r'^\s*(\d+)\s+(\d+)\s+([01])\s*$')
+
+
+def parse_trace(path, keymap, info_path):
+    positions = None
+    if info_path:
+        info = load_json(info_path)
+        layouts = info['layouts']
+        layout = layouts.get(keymap.layout) or next(iter(layouts.values()))
+        positions = {tuple(key['matrix']): index for index, key in enumerate(layout['layout'])}
+
+    events = []
+    with open(path, errors='replace') as trace:
+        for line in trace:
+            if match := TRACE_RE.search(line):
+                if positions is None:
+                    raise SystemExit('TRACE: lines need --info to map matrix positions')
+                index = positions.get((int(match[2]), int(match[3])))
+                if index is not None:
+                    events.append((int(match[1]), index, match[4] == '1'))
+            elif match := INDEX_RE.match(line):
+                events.append((int(match[1]), int(match[2]), match[3] == '1'))
+
+    events.sort(key=lambda event: event[0])
+    return events
+
+
+# --------------------------------------------------------------------------
+# Model
+
+@dataclasses.dataclass
+class Keystroke:
+    index: int
+    pressed_at: int
+    key: Key
+    resolution: str = 'plain'
+    output_at: int = None
+    anchor: int = None            # output length when a tap-hold became a hold
+
+
+@dataclasses.dataclass
+class Output:
+    time: int
+    text: str
+    keystroke: int
+
+
+class Model:
+    def __init__(self, keymap, config):
+        self.keymap = keymap
+        self.config = config
+        self.momentary = collections.Counter()
+        self.locked = set()
+        self.mods = collections.Counter()
+        self.held = {}                # layout index -> (Keystroke, extra state)
+        self.pending_tap_hold = None  # (index, Keystroke, buffered events)
+        self.pending_shift = None     # (index, Keystroke)
+        self.oneshots = {trigger: 'up_unqueued' for trigger in ONESHOTS}
+        self.keystrokes = []
+        self.output = []
+
+    # Layers
+
+    def active_layers(self):
+        active = {self.keymap.default_layer} | self.locked
+        active |= {layer for layer, count in self.momentary.items() if count > 0}
+        return active
+
+    def resolve(self, index):
+        active = self.active_layers()
+        for layer in sorted(active, reverse=True):
+            key = self.keymap.layers[layer][index]
+            if key.kind != 'trans':
+                return key
+        return self.keymap.layers[0][index]
+
+    # One-shot modifiers, the keymaps' is_oneshot_cancel_key() and
+    # is_oneshot_ignored_key().  held is a layer-tap that resolved as a hold.
+
+    @staticmethod
+    def oneshot_cancels(key, held):
+        return key.kind == 'momentary' or (key.kind == 'layer_tap' and held) or key.name == 'STENO'
+
+    @staticmethod
+    def oneshot_ignores(key, held):
+        return key.kind in ('oneshot', 'lock', 'momentary', 'mod') or (key.kind == 'layer_tap' and held)
+
+    def update_oneshots(self, key, down, held=False):
+        """update_oneshot() for each one-shot modifier, see features/oneshot.c."""
+        for trigger, state in self.oneshots.items():
+            mod = ONESHOTS[trigger]
+            if key.kind == 'oneshot' and key.name == trigger:
+                if down:
+                    if state == 'up_unqueued':
+                        self.mods[mod] += 1
+                    state = 'down_unused'
+                elif state == 'down_unused':
+                    state = 'up_queued'
+                elif state == 'down_used':
+                    state = 'up_unqueued'
+                    self.mods[mod] -= 1
+            elif down:
+                if self.oneshot_cancels(key, held) and state != 'up_unqueued':
+                    state = 'up_unqueued'
+                    self.mods[mod] -= 1
+            elif not self.oneshot_ignores(key, held):
+                if state == 'down_unused':
+                    state = 'down_used'
+                elif state == 'up_queued':
+                    state = 'up_unqueued'
+                    self.mods[mod] -= 1
+            self.oneshots[trigger] = state
+
+    # Output
+
+    def emit(self, time, keystroke, shifted=False):
+        key = keystroke.key
+        mods = {m for m, count in self.mods.items() if count > 0} | set(key.mods)
+        if shifted:
+            mods.add('S')
+
+        char = key.char('S' in mods)
+        if key.name == 'BSPC' and not mods - {'S'}:
+            text = '\b'
+        elif char is not None and not mods - {'S'}:
+            text = char
+        else:
+            text = '<%s%s>' % (''.join('%s-' % m for m in sorted(mods - {'S'} if char else mods)), char or key.name)
+
+        self.output.append(Output(time, text, keystroke.index))
+        if keystroke.output_at is None:
+            keystroke.output_at = time
+
+    def flush_shift(self, time, shifted=False):
+        if self.pending_shift:
+            _, keystroke = self.pending_shift
+            keystroke.resolution = 'shifted' if shifted else 'auto_shift'
+            self.emit(time, keystroke, shifted)
+            self.pending_shift = None
+
+    # Timers
+
+    def deadline(self):
+        """Next timer, as (time, 'hold' | 'shift'), or None."""
+        deadlines = []
+        if self.pending_tap_hold:
+            deadlines.append((self.pending_tap_hold[1].pressed_at + self.config.tapping_term, 'hold'))
+        if self.pending_shift:
+            deadlines.append((self.pending_shift[1].pressed_at + self.config.auto_shift_timeout, 'shift'))
+        return min(deadlines, default=None)
+
+    def advance(self, now):
+        while (due := self.deadline()) and due[0] <= now:
+            time, what = due
+            if what == 'hold':
+                self.decide_hold(time)
+            else:
+                self.flush_shift(time, shifted=True)
+
+    # Tap-hold
+
+    def decide_tap(self, now):
+        index, keystroke, buffered = self.pending_tap_hold
+        self.pending_tap_hold = None
+
+        held_for = now - keystroke.pressed_at
+        shifted = self.config.auto_shift and self.config.retro_shift and held_for >= self.config.auto_shift_timeout
+        keystroke.resolution = 'retro_shift' if shifted else 'tap'
+        self.emit(now, keystroke, shifted)
+        del self.held[index]
+        # QMK sends the tap's release straight after its press
+        self.update_oneshots(keystroke.key, False)
+
+        self.replay(now, buffered)
+
+    def decide_hold(self, now):
+        index, keystroke, buffered = self.pending_tap_hold
+        self.pending_tap_hold = None
+
+        keystroke.resolution = 'hold'
+        keystroke.anchor = len(self.output)
+        key = keystroke.key
+        self.update_oneshots(key, True, held=True)
+        if key.kind == 'mod_tap':
+            self.mods.update(key.hold_mods)
+        else:
+            self.momentary[key.layer] += 1
+        # Pressing anything while held uses the hold, no retro shift
+        self.held[index] = (keystroke, {'interrupted': any(down for _, _, down in buffered)})
+
+        self.replay(now, buffered)
+
+    def replay(self, now, buffered):
+        for pressed_at, index, down in buffered:
+            self.handle(now, index, down, pressed_at)
+
+    # Events
+
+    def handle(self, now, index, down, pressed_at=None):
+        pressed_at = now if pressed_at is None else pressed_at
+
+        if self.pending_tap_hold:
+            th_index, _, buffered = self.pending_tap_hold
+            if not down and index == th_index:
+                self.decide_tap(now)
+                return
+            buffered.append((pressed_at, index, down))
+            if not down and self.config.permissive and any(i == index and d for _, i, d in buffered[:-1]):
+                buffered.pop()
+                self.decide_hold(now)
+                self.handle(now, index, down, pressed_at)
+            return
+
+        if down:
+            self.press(now, index, pressed_at)
+        else:
+            self.release(now, index)
+
+    def press(self, now, index, pressed_at):
+        self.flush_shift(now)
+        for keystroke, state in self.held.values():
+            if state is not None:
+                state['interrupted'] = True
+
+        key = self.resolve(index)
+        keystroke = Keystroke(len(self.keystrokes), pressed_at, key)
+        self.keystrokes.append(keystroke)
+        self.held[index] = (keystroke, None)
+
+        if key.tap_hold:
+            self.pending_tap_hold = (index, keystroke, [])
+            self.advance(now)
+            return
+
+        # Tap-hold keys get here once they have been decided
+        self.update_oneshots(key, True)
+        if key.kind == 'plain':
+            # Held or queued one-shots count, get_auto_shifted_key() in the
+            # keymaps turns auto shift off under them
+            plain_mods = not key.mods and not any(count > 0 for count in self.mods.values())
+            if self.config.auto_shift and plain_mods and key.name in AUTO_SHIFTED:
+                self.pending_shift = (index, keystroke)
+                self.advance(now)
+            else:
+                self.emit(now, keystroke)
+        elif key.kind == 'mod':
+            keystroke.resolution = 'modifier'
+            self.mods.update(key.mods)
+        elif key.kind == 'momentary':
+            keystroke.resolution = 'layer'
+            self.momentary[key.layer] += 1
+        elif key.kind == 'oneshot':
+            keystroke.resolution = 'modifier'
+        elif key.kind == 'lock':
+            keystroke.resolution = 'layer'
+            top = max(self.active_layers())
+            if top in self.locked:
+                self.locked.discard(top)
+            elif top != self.keymap.default_layer:
+                self.locked.add(top)
+        elif key.kind == 'other':
+            self.emit(now, keystroke)
+
+    def release(self, now, index):
+        if index not in self.held:
+            return
+        keystroke, state = self.held.pop(index)
+        key = keystroke.key
+
+        # Before auto shift lets a held back key go, as in QMK
+        self.update_oneshots(key, False, held=key.tap_hold)
+
+        if self.pending_shift and self.pending_shift[0] == index:
+            self.flush_shift(now)
+
+        if key.kind == 'mod':
+            self.mods.subtract(key.mods)
+        elif key.kind == 'momentary':
+            self.momentary[key.layer] -= 1
+        elif key.tap_hold and keystroke.resolution == 'hold':
+            if key.kind == 'mod_tap':
+                self.mods.subtract(key.hold_mods)
+            else:
+                self.momentary[key.layer] -= 1
+
+            # Retro shift: a hold that was never used types its tap key
+            held_for = now - keystroke.pressed_at
+            if self.config.retro_shift and not state['interrupted'] and held_for < self.config.retro_shift:
+                shifted = self.config.auto_shift and held_for >= self.config.auto_shift_timeout
+                keystroke.resolution = 'retro_shift' if shifted else 'retro'
+                keystroke.anchor = None
+                self.emit(now, keystroke, shifted)
+
+    def run(self, events):
+        for time, index, down in events:
+            self.advance(time)
+            self.handle(time, index, down)
+        self.advance(math.inf)
+        return self
+
+
+# --------------------------------------------------------------------------
+# Scoring
+
+def final_text(output):
+    """Applies backspaces, returns the surviving (text, keystroke) pairs."""
+    kept = []
+    for out in output:
+        if out.text == '\b':
+            if kept:
+                kept.pop()
+        else:
+            kept.append((out.text, out.keystroke))
+    return kept
+
+
+def score(model, expected):
+    keystrokes = model.keystrokes
+    latencies = [k.output_at - k.pressed_at for k in keystrokes if k.output_at is not None]
+    text = final_text(model.output)
+    produced = [t for t, _ in text]
+
+    result = {
+        'keystrokes': len(keystrokes),
+        'latency': latencies,
+        'holds': sum(k.resolution == 'hold' for k in keystrokes),
+        'shifts': sum(k.resolution in ('shifted', 'retro_shift') for k in keystrokes),
+        'text': ''.join(produced),
+    }
+    if expected is None:
+        return result
+
+    wanted = list(expected)
+    matcher = difflib.SequenceMatcher(None, produced, wanted, autojunk=False)
+    opcodes = matcher.get_opcodes()
+
+    bad_shifts = 0
+    for tag, i1, i2, j1, j2 in opcodes:
+        if tag != 'replace':
+            continue
+        for (out, source), want in zip(text[i1:i2], wanted[j1:j2]):
+            if keystrokes[source].resolution in ('shifted', 'retro_shift') and out != want \
+                    and keystrokes[source].key.char(False) == want:
+                bad_shifts += 1
+
+    # A hold is a misfire when its tap character is missing from the output
+    # right where the hold happened
+    bad_holds = 0
+    for keystroke in keystrokes:
+        if keystroke.resolution != 'hold' or keystroke.anchor is None:
+            continue
+        tap = keystroke.key.char(False)
+        anchor = sum(1 for out in model.output[:keystroke.anchor] if out.text != '\b')
+        for tag, i1, i2, j1, j2 in opcodes:
+            if tag in ('insert', 'replace') and i1 <= min(anchor, len(produced)) <= i2 and tap in wanted[j1:j2]:
+                bad_holds += 1
+                break
+
+    distance = sum(max(i2 - i1, j2 - j1) for tag, i1, i2, j1, j2 in opcodes if tag != 'equal')
+    result.update(bad_holds=bad_holds, bad_shifts=bad_shifts, distance=distance)
+    return result
+
+
+def percentile(values, fraction):
+    if not values:
+        return 0
+    ordered = sorted(values)
+    return ordered[min(len(ordered) - 1, int(fraction * len(ordered)))]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n\n')[0])
+    parser.add_argument('keymap', help='keymap directory (keymap.c, config.h, rules.mk)')
+    parser.add_argument('trace', help='console log with TRACE: lines, or <ms> <index> <1|0> lines')
+    parser.add_argument('--info', help='keyboard.json / info.json for the matrix to layout mapping')
+    parser.add_argument('--expect', help='file with the text that was meant to be typed')
+    parser.add_argument('--config', action='append', default=[], metavar='NAME:KEY=VALUE,...',
+                        help='extra configuration, on top of the keymap one (tapping_term, permissive, '
+                             'auto_shift, auto_shift_timeout, retro_shift)')
+    parser.add_argument('--sweep', action='append', default=[], metavar='KEY=START:STOP:STEP',
+                        help='one configuration per value of a setting')
+    parser.add_argument('--diff', action='store_true', help='print the output text diff for each configuration')
+    args = parser.parse_args()
+
+    keymap = parse_keymap(args.keymap)
+    events = parse_trace(args.trace, keymap, args.info)
+    if not events:
+        sys.exit('no key events in %s' % args.trace)
+    expected = open(args.expect).read() if args.expect else None
+
+    base = keymap_config(args.keymap)
+    configs = [base] + [config_from_spec(base, spec) for spec in args.config]
+    for sweep in args.sweep:
+        key, _, span = sweep.partition('=')
+        start, stop, step = (int(v) for v in span.split(':'))
+        for value in range(start, stop + 1, step):
+            config = dataclasses.replace(base, name='%s=%d' % (key, value))
+            set_field(config, key, str(value))
+            configs.append(config)
+
+    print('%d key events, layout %s, default layer %s\n' % (
+        len(events), keymap.layout, keymap.names.get(keymap.default_layer, keymap.default_layer)))
+    header = '%-24s %6s %7s %5s %5s %5s %6s %6s' % ('config', 'keys', 'avg ms', 'p50', 'p95', 'max', 'holds', 'shifts')
+    if expected is not None:
+        header += ' %9s %10s %5s' % ('bad holds', 'bad shifts', 'edits')
+    print(header)
+
+    results = []
+    for config in configs:
+        result = score(Model(keymap, config).run(events), expected)
+        results.append((config, result))
+        latency = result['latency']
+        line = '%-24s %6d %7.1f %5d %5d %5d %6d %6d' % (
+            config.name, result['keystrokes'], statistics.mean(latency) if latency else 0,
+            percentile(latency, 0.5), percentile(latency, 0.95), max(latency, default=0),
+            result['holds'], result['shifts'])
+        if expected is not None:
+            line += ' %9d %10d %5d' % (result['bad_holds'], result['bad_shifts'], result['distance'])
+        print(line)
+
+    print()
+    for config, _ in results:
+        print('%-24s %s' % (config.name, config.describe()))
+
+    if args.diff:
+        reference = expected if expected is not None else results[0][1]['text']
+        for config, result in results:
+            print('\n--- %s' % config.name)
+            diff = difflib.unified_diff(reference.splitlines(), result['text'].splitlines(),
+                                        'expected' if expected is not None else 'keymap', config.name, lineterm='')
+            print('\n'.join(diff) or '(same)')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,153 @@
+#!/usr/bin/env python3
+"""Stack and RAM headroom report for the filbar keymaps.
+
+Reads the `MEM:` lines a keyboard built with MEM_STATS_ENABLE prints to the
+console (press STATS on the config layer), optionally combined with the
+linker map QMK leaves next to the firmware in .build/, and prints:
+
+  * high-water mark and headroom of each stack
+  * .data/.bss/heap totals
+  * static RAM per feature (from the map)
+
+Exits non-zero when any headroom is below the given thresholds, so it can be
+used as a build-and-run check:
+
+    qmk console | tee console.log
+    tools/mem_report.py console.log --map .build/splitkb_aurora_lily58_rev1_filbar.map \\
+        --min-stack-headroom 256 --min-heap-headroom 4096
+"""
+
+import argparse
+import collections
+import re
+import sys
+
+STACK_RE = re.compile(r'MEM: stack (\w+) (\d+)/(\d+)')
+TOTAL_RE = re.compile(r'MEM: (data|bss) (\d+)')
+HEAP_RE = re.compile(r'MEM: heap (\d+)/(\d+)')
+
+# An input section in the map, either on one line or with the address and
+# size wrapped onto the next one.
+SECTION_RE = re.compile(r'^ (\.(?:data|bss)[^\s]*|COMMON)(?:\s+(0x[0-9a-f]+)\s+(0x[0-9a-f]+)\s+(.+))?$')
+WRAPPED_RE = re.compile(r'^\s+(0x[0-9a-f]+)\s+(0x[0-9a-f]+)\s+(.+)$')
+
+# Source directories that are reported as a single block
+CORE_DIRS = ('quantum', 'tmk_core', 'platforms', 'drivers', 'chibios', 'pico-sdk', 'printf')
+
+
+def parse_console(path):
+    stacks = collections.OrderedDict()
+    totals = {}
+    heap = None
+
+    with open(path, errors='replace') as log:
+        for line in log:
+            # Later dumps supersede earlier ones
+            if match := STACK_RE.search(line):
+                stacks[match[1]] = (int(match[2]), int(match[3]))
+            elif match := TOTAL_RE.search(line):
+                totals[match[1]] = int(match[2])
+            elif match := HEAP_RE.search(line):
+                heap = (int(match[1]), int(match[2]))
+
+    return stacks, totals, heap
+
+
+def owner_of(obj):
+    """Groups an object file (or archive member) under a feature name."""
+    obj = obj.strip()
+    if '/features/' in obj:
+        return 'features/' + re.sub(r'\.o\)?$', '', obj.rsplit('/features/', 1)[1])
+    if re.search(r'keymap(_introspection)?\.o$', obj):
+        return 'keymap'
+    for part in CORE_DIRS:
+        if f'/{part}/' in obj or obj.startswith(f'{part}/'):
+            return part
+    return re.sub(r'\.o\)?$', '', obj.rsplit('/', 1)[-1])
+
+
+def parse_map(path):
+    usage = collections.defaultdict(lambda: {'data': 0, 'bss': 0})
+    in_memory_map = False
+    pending = None
+
+    with open(path, errors='replace') as linker_map:
+        for line in linker_map:
+            line = line.rstrip('\n')
+            if line.startswith('Linker script and memory map'):
+                in_memory_map = True
+                continue
+            if not in_memory_map:
+                continue
+
+            if pending:
+                match = WRAPPED_RE.match(line)
+                if match:
+                    add_section(usage, pending, int(match[2], 16), match[3])
+                pending = None
+                continue
+
+            match = SECTION_RE.match(line)
+            if not match:
+                continue
+            if match[2] is None:
+                pending = match[1]
+            else:
+                add_section(usage, match[1], int(match[3], 16), match[4])
+
+    return usage
+
+
+def add_section(usage, section, size, obj):
+    if size == 0:
+        return
+    kind = 'data' if section.startswith('.data') else 'bss'
+    usage[owner_of(obj)][kind] += size
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('console', help='console log containing MEM: lines')
+    parser.add_argument('--map', help='linker map for the per-feature breakdown')
+    parser.add_argument('--min-stack-headroom', type=int, default=0, help='fail when any stack has fewer free bytes')
+    parser.add_argument('--min-heap-headroom', type=int, default=0, help='fail when the heap has fewer free bytes')
+    args = parser.parse_args()
+
+    stacks, totals, heap = parse_console(args.console)
+    if not stacks:
+        print(f'{args.console}: no MEM: lines, was the firmware built with MEM_STATS_ENABLE?', file=sys.stderr)
+        return 2
+
+    failures = []
+
+    print('Stacks')
+    for name, (used, size) in stacks.items():
+        headroom = size - used
+        print(f'  {name:<10} {used:>6} / {size:<6} used, {headroom:>6} free')
+        if headroom < args.min_stack_headroom:
+            failures.append(f'{name} stack has {headroom} bytes free, need {args.min_stack_headroom}')
+
+    print('RAM')
+    for kind in ('data', 'bss'):
+        if kind in totals:
+            print(f'  .{kind:<9} {totals[kind]:>6}')
+    if heap:
+        used, size = heap
+        headroom = size - used
+        print(f'  {"heap":<10} {used:>6} / {size:<6} used, {headroom:>6} free')
+        if headroom < args.min_heap_headroom:
+            failures.append(f'heap has {headroom} bytes free, need {args.min_heap_headroom}')
+
+    if args.map:
+        usage = parse_map(args.map)
+        print('Static RAM by feature')
+        for owner, sizes in sorted(usage.items(), key=lambda item: -(item[1]['data'] + item[1]['bss'])):
+            print(f'  {owner:<28} {sizes["data"]:>6} data {sizes["bss"]:>6} bss')
+
+    for failure in failures:
+        print(f'FAIL: {failure}', file=sys.stderr)
+    return 1 if failures else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
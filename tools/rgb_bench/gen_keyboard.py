@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+"""Generates the keyboard side of the RGB bench from keyboard.json.
+
+QMK builds the matrix size, LAYOUT macros and g_led_config from the
+keyboard's keyboard.json / info.json, this does the same for the host
+bench, plus keycode values for every identifier the keymap uses:
+
+    gen_keyboard.py <keyboard.json> <keymap dir> <output dir>
+
+writes <output dir>/bench_keyboard.h and <output dir>/led_config.c.
+
+Basic keycodes get their HID values and layer and mod keys QMK's ranges,
+so range checks in the features behave.  Anything else the keymap uses
+(RGB_TOG, QK_GESC, ...) only gets a distinct placeholder value.
+"""
+
+import os
+import re
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..'))
+
+import latency_model  # noqa: E402
+
+HID = {
+    'NO': 0x00, 'TRNS': 0x01, 'TRANSPARENT': 0x01,
+    'ENT': 0x28, 'ENTER': 0x28, 'ESC': 0x29, 'ESCAPE': 0x29, 'BSPC': 0x2A, 'BACKSPACE': 0x2A, 'TAB': 0x2B,
+    'SPC': 0x2C, 'SPACE': 0x2C, 'MINS': 0x2D, 'MINUS': 0x2D, 'EQL': 0x2E, 'EQUAL': 0x2E,
+    'LBRC': 0x2F, 'RBRC': 0x30, 'BSLS': 0x31, 'SCLN': 0x33, 'QUOT': 0x34, 'GRV': 0x35,
+    'COMM': 0x36, 'DOT': 0x37, 'SLSH': 0x38, 'CAPS': 0x39,
+    'PSCR': 0x46, 'SCRL': 0x47, 'PAUS': 0x48, 'INS': 0x49, 'HOME': 0x4A, 'PGUP': 0x4B, 'DEL': 0x4C,
+    'END': 0x4D, 'PGDN': 0x4E, 'RGHT': 0x4F, 'RIGHT': 0x4F, 'LEFT': 0x50, 'DOWN': 0x51, 'UP': 0x52,
+    'MUTE': 0xA8, 'VOLU': 0xA9, 'VOLD': 0xAA, 'MNXT': 0xAB, 'MPRV': 0xAC, 'MSTP': 0xAD, 'MPLY': 0xAE,
+    'BRIU': 0xBD, 'BRID': 0xBE,
+    'MS_U': 0xCD, 'MS_D': 0xCE, 'MS_L': 0xCF, 'MS_R': 0xD0,
+    'BTN1': 0xD1, 'BTN2': 0xD2, 'BTN3': 0xD3, 'BTN4': 0xD4, 'BTN5': 0xD5,
+    'WH_U': 0xD9, 'WH_D': 0xDA, 'WH_L': 0xDB, 'WH_R': 0xDC,
+    'LCTL': 0xE0, 'LSFT': 0xE1, 'LALT': 0xE2, 'LOPT': 0xE2, 'LGUI': 0xE3, 'LCMD': 0xE3,
+    'RCTL': 0xE4, 'RSFT': 0xE5, 'RALT': 0xE6, 'ROPT': 0xE6, 'RGUI': 0xE7, 'RCMD': 0xE7,
+}
+for i, letter in enumerate('ABCDEFGHIJKLMNOPQRSTUVWXYZ'):
+    HID[letter] = 0x04 + i
+for i, digit in enumerate('1234567890'):
+    HID[digit] = 0x1E + i
+for i in range(12):
+    HID['F%d' % (i + 1)] = 0x3A + i
+
+# KC_LT is S(KC_COMM) and so on
+SHIFTED = {name: 0x0200 | HID[base] for name, base in latency_model.SHIFTED.items()}
+
+PLACEHOLDER_BASE = 0x7C00
+
+
+def static_keycodes():
+    """Names qmk/keycodes.h already defines, KC_NO, the QK_ ranges and so on."""
+    header = os.path.join(os.path.dirname(os.path.abspath(__file__)), 'qmk', 'keycodes.h')
+    return set(re.findall(r'^#define (\w+)', open(header).read(), re.M))
+
+
+def layouts(info):
+    for name, layout in info.get('layouts', {}).items():
+        yield name, [tuple(key['matrix']) for key in layout['layout']]
+
+
+def main():
+    if len(sys.argv) != 4:
+        sys.exit(__doc__)
+    info_path, keymap_dir, out_dir = sys.argv[1:]
+    info = latency_model.load_json(info_path)
+    rgb = info.get('rgb_matrix', {})
+    leds = rgb.get('layout', [])
+    if not leds:
+        sys.exit('%s has no rgb_matrix layout' % info_path)
+
+    positions = [pos for _, keys in layouts(info) for pos in keys]
+    positions += [tuple(led['matrix']) for led in leds if 'matrix' in led]
+    rows = max(r for r, _ in positions) + 1
+    cols = max(c for _, c in positions) + 1
+
+    keymap_src = latency_model.strip_comments(open(os.path.join(keymap_dir, 'keymap.c')).read())
+    defines = latency_model.parse_defines(keymap_src)
+    layers = latency_model.parse_layers(keymap_src)
+    default = defines.get('DEFAULT_LAYER', '0')
+    default = layers.get(default, default)
+    defined = [layers[name] for name in re.findall(r'\[(\w+)\]\s*=\s*LAYOUT\w*\(', keymap_src)]
+
+    used = set(re.findall(r'\b(?:KC|QK|RGB|RM|UG|AS|DT|CW|EE|MS|OS)_[A-Za-z0-9_]+\b', keymap_src))
+    used = {ident for ident in used if not ident.startswith('RGB_MATRIX') and not ident.endswith('_ENABLE')}
+    # The keymap's own keycodes (OS_SHFT, ...) are enum members, not QMK's
+    for body in re.findall(r'\benum\s+\w*\s*\{([^}]*)\}', keymap_src):
+        used -= set(re.findall(r'(\w+)\s*(?:=[^,]*)?(?:,|$)', body.strip()))
+
+    os.makedirs(out_dir, exist_ok=True)
+    with open(os.path.join(out_dir, 'bench_keyboard.h'), 'w') as out:
+        out.write('// Generated by tools/rgb_bench/gen_keyboard.py from %s, do not edit\n' % info_path)
+        out.write('#pragma once\n\n')
+        out.write('#define MATRIX_ROWS %d\n#define MATRIX_COLS %d\n' % (rows, cols))
+        out.write('#define RGB_MATRIX_LED_COUNT %d\n' % len(leds))
+        if 'split_count' in rgb:
+            out.write('#define RGB_MATRIX_SPLIT {%s}\n' % ', '.join(str(n) for n in rgb['split_count']))
+        out.write('#define BENCH_DEFAULT_LAYER %s\n' % default)
+        out.write('#define BENCH_LAYER_COUNT %d\n' % (max(defined) + 1))
+        if 'split_count' in rgb or info.get('split', {}).get('enabled'):
+            out.write('#define SPLIT_KEYBOARD\n')
+        out.write('\n')
+
+        for name, keys in layouts(info):
+            args = ', '.join('k%d' % i for i in range(len(keys)))
+            body = ', '.join('[%d][%d] = k%d' % (r, c, i) for i, (r, c) in enumerate(keys))
+            out.write('#define %s(%s) { %s }\n' % (name, args, body))
+        out.write('\n')
+
+        placeholder = PLACEHOLDER_BASE
+        for ident in sorted(used - static_keycodes()):
+            prefix, _, name = ident.partition('_')
+            if prefix == 'KC' and name in HID:
+                value = HID[name]
+            elif prefix == 'KC' and name in SHIFTED:
+                value = SHIFTED[name]
+            else:
+                value, placeholder = placeholder, placeholder + 1
+            out.write('#define %s 0x%04X\n' % (ident, value))
+
+    with open(os.path.join(out_dir, 'led_config.c'), 'w') as out:
+        out.write('// Generated by tools/rgb_bench/gen_keyboard.py from %s, do not edit\n' % info_path)
+        out.write('#include "quantum.h"\n\n')
+        out.write('led_config_t g_led_config = {\n    .matrix_co = {\n')
+        matrix = [['NO_LED'] * cols for _ in range(rows)]
+        for index, led in enumerate(leds):
+            if 'matrix' in led:
+                r, c = led['matrix']
+                matrix[r][c] = str(index)
+        for row in matrix:
+            out.write('        { %s },\n' % ', '.join(row))
+        out.write('    },\n    .point = {\n')
+        for led in leds:
+            out.write('        { %d, %d },\n' % (led['x'], led['y']))
+        out.write('    },\n    .flags = {\n')
+        for led in leds:
+            out.write('        %d,\n' % led['flags'])
+        out.write('    },\n};\n')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,356 @@
+// The QMK side of the RGB bench: timers, layers, the LED buffer and the RGB
+// matrix state, driven by rgb_bench.c.  Everything that would talk to the
+// host or the other half is a no-op.
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "quantum.h"
+#include "host.h"
+#include "qmk/host.h"
+
+// Bench state
+
+uint32_t     bench_time;
+bool         bench_left = true;
+matrix_row_t bench_matrix[MATRIX_ROWS];
+RGB          bench_leds[RGB_MATRIX_LED_COUNT];
+
+uint8_t  rgb_matrix_led_process_limit;
+uint32_t g_rgb_timer;
+
+static struct {
+    bool    enable;
+    uint8_t mode;
+    HSV     hsv;
+    uint8_t speed;
+} rgb_config = {
+    .enable = true,
+    .mode   = RGB_MATRIX_SOLID_COLOR,
+    .hsv    = {.h = 0, .s = 255, .v = 128},
+    .speed  = 128,
+};
+
+keymap_config_t keymap_config;
+
+static report_keyboard_t report;
+report_keyboard_t       *keyboard_report = &report;
+
+bool debug_enable;
+bool debug_matrix;
+bool debug_keyboard;
+bool debug_mouse;
+
+// Timers
+
+uint16_t timer_read(void) {
+    return (uint16_t)bench_time;
+}
+
+uint32_t timer_read32(void) {
+    return bench_time;
+}
+
+uint16_t timer_elapsed(uint16_t last) {
+    return TIMER_DIFF_16(timer_read(), last);
+}
+
+uint32_t timer_elapsed32(uint32_t last) {
+    return TIMER_DIFF_32(timer_read32(), last);
+}
+
+// The bench is always typing, nothing should dim or sleep
+uint32_t last_input_activity_elapsed(void) {
+    return 0;
+}
+
+uint32_t last_matrix_activity_elapsed(void) {
+    return 0;
+}
+
+// Matrix and keymap, keymap_key_to_keycode() is features/sparse_keymap.c
+
+matrix_row_t matrix_get_row(uint8_t row) {
+    return bench_matrix[row];
+}
+
+// Nothing is typed on the bench
+void action_exec(keyevent_t event) {}
+
+uint8_t keymap_layer_count(void) {
+    return BENCH_LAYER_COUNT;
+}
+
+// Layers
+
+layer_state_t layer_state;
+layer_state_t default_layer_state;
+
+uint8_t get_highest_layer(layer_state_t state) {
+    return state ? 31 - __builtin_clz(state) : 0;
+}
+
+bool layer_state_cmp(layer_state_t state, uint8_t layer) {
+    return state ? (state & ((layer_state_t)1 << layer)) != 0 : layer == 0;
+}
+
+bool layer_state_is(uint8_t layer) {
+    return layer_state_cmp(layer_state, layer);
+}
+
+void layer_on(uint8_t layer) {
+    layer_state |= (layer_state_t)1 << layer;
+}
+
+void layer_off(uint8_t layer) {
+    layer_state &= ~((layer_state_t)1 << layer);
+}
+
+void layer_move(uint8_t layer) {
+    layer_state = (layer_state_t)1 << layer;
+}
+
+void layer_invert(uint8_t layer) {
+    layer_state ^= (layer_state_t)1 << layer;
+}
+
+void layer_and(layer_state_t state) {
+    layer_state &= state;
+}
+
+void default_layer_set(layer_state_t state) {
+    default_layer_state = state;
+}
+
+// Keys and mods, nothing reaches a host
+
+void register_code(uint8_t code) {}
+void unregister_code(uint8_t code) {}
+void tap_code(uint8_t code) {}
+void register_code16(uint16_t code) {}
+void unregister_code16(uint16_t code) {}
+void tap_code16(uint16_t code) {}
+
+uint8_t get_mods(void) {
+    return 0;
+}
+
+uint8_t get_oneshot_mods(void) {
+    return 0;
+}
+
+void clear_oneshot_mods(void) {}
+void clear_mods(void) {}
+void set_mods(uint8_t mods) {}
+void add_weak_mods(uint8_t mods) {}
+void clear_weak_mods(void) {}
+void del_weak_mods(uint8_t mods) {}
+void send_char(char ascii_code) {}
+void send_keyboard_report(void) {}
+void add_key(uint8_t key) {}
+void del_key(uint8_t key) {}
+void add_mods(uint8_t mods) {}
+void del_mods(uint8_t mods) {}
+
+void virtser_send(const uint8_t byte) {}
+
+host_driver_t *host_get_driver(void) {
+    return NULL;
+}
+
+void host_set_driver(host_driver_t *driver) {}
+
+uint8_t get_oneshot_layer(void) {
+    return 0;
+}
+
+void reset_oneshot_layer(void) {}
+
+bool is_caps_word_on(void) {
+    return false;
+}
+
+void caps_word_on(void) {}
+void caps_word_off(void) {}
+
+// EECONFIG, every run starts blank
+
+void eeconfig_read_user_datablock(void *data) {}
+void eeconfig_update_user_datablock(const void *data) {}
+
+// OLED, drawing goes nowhere
+
+uint8_t oled_max_chars(void) {
+    return 21;
+}
+
+uint8_t oled_max_lines(void) {
+    return 4;
+}
+
+void oled_clear(void) {}
+void oled_set_cursor(uint8_t col, uint8_t line) {}
+void oled_write_char(const char data, bool invert) {}
+
+// Split keyboard, the bench renders as the master of either half
+
+bool is_keyboard_master(void) {
+    return true;
+}
+
+bool is_keyboard_left(void) {
+    return bench_left;
+}
+
+bool is_transport_connected(void) {
+    return true;
+}
+
+void transaction_register_rpc(int8_t transaction_id, void (*callback)(uint8_t, const void *, uint8_t, void *)) {}
+
+bool transaction_rpc_send(int8_t transaction_id, uint8_t size, const void *buffer) {
+    return true;
+}
+
+bool transaction_rpc_recv(int8_t transaction_id, uint8_t size, void *buffer) {
+    return true;
+}
+
+bool transaction_rpc_exec(int8_t transaction_id, uint8_t in_size, const void *in, uint8_t out_size, void *out) {
+    return true;
+}
+
+// Colour, QMK's hsv_to_rgb() without the CIE curve
+
+RGB hsv_to_rgb(HSV hsv) {
+    if (hsv.s == 0) {
+        return (RGB){.r = hsv.v, .g = hsv.v, .b = hsv.v};
+    }
+
+    const uint16_t h         = hsv.h;
+    const uint16_t s         = hsv.s;
+    const uint16_t v         = hsv.v;
+    const uint8_t  region    = h * 6 / 255;
+    const uint8_t  remainder = (h * 2 - region * 85) * 3;
+    const uint8_t  p         = (v * (255 - s)) >> 8;
+    const uint8_t  q         = (v * (255 - ((s * remainder) >> 8))) >> 8;
+    const uint8_t  t         = (v * (255 - ((s * (255 - remainder)) >> 8))) >> 8;
+
+    switch (region) {
+        case 6:
+        case 0:
+            return (RGB){.r = v, .g = t, .b = p};
+        case 1:
+            return (RGB){.r = q, .g = v, .b = p};
+        case 2:
+            return (RGB){.r = p, .g = v, .b = t};
+        case 3:
+            return (RGB){.r = p, .g = q, .b = v};
+        case 4:
+            return (RGB){.r = t, .g = p, .b = v};
+        default:
+            return (RGB){.r = v, .g = p, .b = q};
+    }
+}
+
+RGB rgb_matrix_hsv_to_rgb(HSV hsv) {
+    return hsv_to_rgb(hsv);
+}
+
+// RGB matrix
+
+void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+    if (index >= 0 && index < RGB_MATRIX_LED_COUNT) {
+        bench_leds[index] = (RGB){.r = red, .g = green, .b = blue};
+    }
+}
+
+void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        rgb_matrix_set_color(i, red, green, blue);
+    }
+}
+
+bool rgb_matrix_check_finished_leds(uint8_t led_idx) {
+#ifdef RGB_MATRIX_SPLIT
+    const uint8_t k_rgb_matrix_split[2] = RGB_MATRIX_SPLIT;
+    if (is_keyboard_left()) {
+        return led_idx < k_rgb_matrix_split[0];
+    }
+#endif
+    return led_idx < RGB_MATRIX_LED_COUNT;
+}
+
+bool rgb_matrix_is_enabled(void) {
+    return rgb_config.enable;
+}
+
+void rgb_matrix_enable_noeeprom(void) {
+    rgb_config.enable = true;
+}
+
+void rgb_matrix_disable_noeeprom(void) {
+    rgb_config.enable = false;
+}
+
+uint8_t rgb_matrix_get_mode(void) {
+    return rgb_config.mode;
+}
+
+void rgb_matrix_mode_noeeprom(uint8_t mode) {
+    rgb_config.mode = mode;
+}
+
+uint8_t rgb_matrix_get_hue(void) {
+    return rgb_config.hsv.h;
+}
+
+uint8_t rgb_matrix_get_sat(void) {
+    return rgb_config.hsv.s;
+}
+
+uint8_t rgb_matrix_get_val(void) {
+    return rgb_config.hsv.v;
+}
+
+uint8_t rgb_matrix_get_speed(void) {
+    return rgb_config.speed;
+}
+
+void rgb_matrix_sethsv_noeeprom(uint8_t hue, uint8_t sat, uint8_t val) {
+    rgb_config.hsv = (HSV){.h = hue, .s = sat, .v = val};
+}
+
+void rgb_matrix_set_speed_noeeprom(uint8_t speed) {
+    rgb_config.speed = speed;
+}
+
+void rgb_matrix_reload_from_eeprom(void) {}
+
+// OLED
+
+bool oled_on(void) {
+    return true;
+}
+
+bool oled_off(void) {
+    return false;
+}
+
+bool is_oled_on(void) {
+    return true;
+}
+
+// QMK's weak keymap callbacks, for keymaps that leave some out
+
+__attribute__((weak)) void keyboard_pre_init_user(void) {}
+__attribute__((weak)) void keyboard_post_init_user(void) {}
+__attribute__((weak)) void matrix_scan_user(void) {}
+__attribute__((weak)) void housekeeping_task_user(void) {}
+
+__attribute__((weak)) bool rgb_matrix_indicators_user(void) {
+    return true;
+}
+
+__attribute__((weak)) bool rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max) {
+    return true;
+}
@@ -0,0 +1,24 @@
+// State the bench drives the stand-in QMK with, see host.c.
+#pragma once
+
+#include "quantum.h"
+
+// Milliseconds for every QMK timer
+extern uint32_t bench_time;
+
+// Half being rendered, for split keyboards
+extern bool bench_left;
+
+// Debounced matrix as matrix_get_row() reports it
+extern matrix_row_t bench_matrix[MATRIX_ROWS];
+
+// What rgb_matrix_set_color() wrote
+extern RGB bench_leds[RGB_MATRIX_LED_COUNT];
+
+// Keymap callbacks the bench runs, QMK declares these in its own headers
+void keyboard_pre_init_user(void);
+void keyboard_post_init_user(void);
+void matrix_scan_user(void);
+void housekeeping_task_user(void);
+bool rgb_matrix_indicators_user(void);
+bool rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max);
@@ -0,0 +1,16 @@
+// Stand-in for QMK's host.h, there is no host driver on the bench so
+// features/host_hook.c never installs its proxy.
+#pragma once
+
+#include "quantum.h"
+
+typedef struct {
+    uint8_t (*keyboard_leds)(void);
+    void (*send_keyboard)(report_keyboard_t *);
+    void (*send_nkro)(void *);
+    void (*send_mouse)(void *);
+    void (*send_extra)(void *);
+} host_driver_t;
+
+host_driver_t *host_get_driver(void);
+void           host_set_driver(host_driver_t *driver);
@@ -0,0 +1,119 @@
+// Keycode ranges and helpers from QMK's keycodes.h, enough for the keymaps
+// and features to compile.  Per-keymap keycodes come from bench_keyboard.h.
+#pragma once
+
+#define KC_NO 0x0000
+#define KC_TRNS 0x0001
+#define KC_TRANSPARENT KC_TRNS
+#define XXXXXXX KC_NO
+#define _______ KC_TRNS
+
+#define QK_MODS 0x0100
+#define QK_MODS_MAX 0x1FFF
+#define QK_MOD_TAP 0x2000
+#define QK_MOD_TAP_MAX 0x3FFF
+#define QK_LAYER_TAP 0x4000
+#define QK_LAYER_TAP_MAX 0x4FFF
+#define QK_LAYER_MOD 0x5000
+#define QK_LAYER_MOD_MAX 0x51FF
+#define QK_TO 0x5200
+#define QK_TO_MAX 0x521F
+#define QK_MOMENTARY 0x5220
+#define QK_MOMENTARY_MAX 0x523F
+#define QK_DEF_LAYER 0x5240
+#define QK_DEF_LAYER_MAX 0x525F
+#define QK_TOGGLE_LAYER 0x5260
+#define QK_TOGGLE_LAYER_MAX 0x527F
+#define QK_ONE_SHOT_LAYER 0x5280
+#define QK_ONE_SHOT_LAYER_MAX 0x529F
+#define QK_ONE_SHOT_MOD 0x52A0
+#define QK_ONE_SHOT_MOD_MAX 0x52BF
+#define QK_LAYER_TAP_TOGGLE 0x52C0
+#define QK_LAYER_TAP_TOGGLE_MAX 0x52DF
+#define QK_STENO 0x74C0
+#define QK_STENO_BOLT 0x74F0
+#define QK_STENO_GEMINI 0x74F1
+#define QK_USER 0x7E40
+#define QK_USER_MAX 0x7FFF
+#define SAFE_RANGE QK_USER
+
+#define MOD_LCTL 0x01
+#define MOD_LSFT 0x02
+#define MOD_LALT 0x04
+#define MOD_LGUI 0x08
+#define MOD_RCTL 0x11
+#define MOD_RSFT 0x12
+#define MOD_RALT 0x14
+#define MOD_RGUI 0x18
+#define MOD_BIT(kc) (1 << ((kc) & 0x07))
+#define MOD_MASK_CTRL 0x11
+#define MOD_MASK_SHIFT 0x22
+#define MOD_MASK_ALT 0x44
+#define MOD_MASK_GUI 0x88
+
+#define LCTL(kc) ((MOD_LCTL << 8) | (kc))
+#define LSFT(kc) ((MOD_LSFT << 8) | (kc))
+#define LALT(kc) ((MOD_LALT << 8) | (kc))
+#define LGUI(kc) ((MOD_LGUI << 8) | (kc))
+#define RCTL(kc) ((MOD_RCTL << 8) | (kc))
+#define RSFT(kc) ((MOD_RSFT << 8) | (kc))
+#define RALT(kc) ((MOD_RALT << 8) | (kc))
+#define RGUI(kc) ((MOD_RGUI << 8) | (kc))
+#define C(kc) LCTL(kc)
+#define S(kc) LSFT(kc)
+#define A(kc) LALT(kc)
+#define G(kc) LGUI(kc)
+
+#define MT(mod, kc) (QK_MOD_TAP | (((mod) & 0x1F) << 8) | ((kc) & 0xFF))
+#define LCTL_T(kc) MT(MOD_LCTL, kc)
+#define LSFT_T(kc) MT(MOD_LSFT, kc)
+#define LALT_T(kc) MT(MOD_LALT, kc)
+#define LGUI_T(kc) MT(MOD_LGUI, kc)
+#define RCTL_T(kc) MT(MOD_RCTL, kc)
+#define RSFT_T(kc) MT(MOD_RSFT, kc)
+#define RALT_T(kc) MT(MOD_RALT, kc)
+#define RGUI_T(kc) MT(MOD_RGUI, kc)
+#define LCMD_T(kc) LGUI_T(kc)
+#define RCMD_T(kc) RGUI_T(kc)
+#define LOPT_T(kc) LALT_T(kc)
+#define ROPT_T(kc) RALT_T(kc)
+
+#define LT(layer, kc) (QK_LAYER_TAP | (((layer) & 0xF) << 8) | ((kc) & 0xFF))
+#define LM(layer, mod) (QK_LAYER_MOD | (((layer) & 0xF) << 5) | ((mod) & 0x1F))
+#define TO(layer) (QK_TO | ((layer) & 0x1F))
+#define MO(layer) (QK_MOMENTARY | ((layer) & 0x1F))
+#define DF(layer) (QK_DEF_LAYER | ((layer) & 0x1F))
+#define TG(layer) (QK_TOGGLE_LAYER | ((layer) & 0x1F))
+#define OSL(layer) (QK_ONE_SHOT_LAYER | ((layer) & 0x1F))
+#define OSM(mod) (QK_ONE_SHOT_MOD | ((mod) & 0x1F))
+#define TT(layer) (QK_LAYER_TAP_TOGGLE | ((layer) & 0x1F))
+
+#define IS_QK_BASIC(kc) ((kc) >= 0x0004 && (kc) <= 0x00FF)
+#define IS_QK_MODS(kc) ((kc) >= QK_MODS && (kc) <= QK_MODS_MAX)
+#define IS_QK_MOD_TAP(kc) ((kc) >= QK_MOD_TAP && (kc) <= QK_MOD_TAP_MAX)
+#define IS_QK_LAYER_TAP(kc) ((kc) >= QK_LAYER_TAP && (kc) <= QK_LAYER_TAP_MAX)
+#define IS_QK_MOMENTARY(kc) ((kc) >= QK_MOMENTARY && (kc) <= QK_MOMENTARY_MAX)
+#define IS_QK_DEF_LAYER(kc) ((kc) >= QK_DEF_LAYER && (kc) <= QK_DEF_LAYER_MAX)
+#define IS_QK_TOGGLE_LAYER(kc) ((kc) >= QK_TOGGLE_LAYER && (kc) <= QK_TOGGLE_LAYER_MAX)
+#define KC_LEFT_CTRL 0x00E0
+#define KC_LEFT_SHIFT 0x00E1
+#define IS_MODIFIER_KEYCODE(kc) ((kc) >= 0x00E0 && (kc) <= 0x00E7)
+#define IS_RETRO(kc) (IS_QK_MOD_TAP(kc) || IS_QK_LAYER_TAP(kc))
+
+// Auto Shift's default keys, for case labels
+#define AUTO_SHIFT_ALPHA 0x0004 ... 0x001D
+#define AUTO_SHIFT_NUMERIC 0x001E ... 0x0027
+#define AUTO_SHIFT_SYMBOLS 0x002D ... 0x0038: case 0x0064
+
+#define QK_MODS_GET_BASIC_KEYCODE(kc) ((kc) & 0xFF)
+#define QK_MODS_GET_MODS(kc) (((kc) >> 8) & 0x1F)
+#define QK_MOD_TAP_GET_TAP_KEYCODE(kc) ((kc) & 0xFF)
+#define QK_MOD_TAP_GET_MODS(kc) (((kc) >> 8) & 0x1F)
+#define QK_LAYER_TAP_GET_TAP_KEYCODE(kc) ((kc) & 0xFF)
+#define QK_LAYER_TAP_GET_LAYER(kc) (((kc) >> 8) & 0xF)
+#define QK_LAYER_MOD_GET_LAYER(kc) (((kc) >> 5) & 0xF)
+#define QK_LAYER_MOD_GET_MODS(kc) ((kc) & 0x1F)
+#define QK_MOMENTARY_GET_LAYER(kc) ((kc) & 0x1F)
+#define QK_DEF_LAYER_GET_LAYER(kc) ((kc) & 0x1F)
+#define QK_TOGGLE_LAYER_GET_LAYER(kc) ((kc) & 0x1F)
+#define QK_LAYER_TAP_TOGGLE_GET_LAYER(kc) ((kc) & 0x1F)
@@ -0,0 +1,6 @@
+// Stand-in for QMK's keymap_introspection.h, see host.c.
+#pragma once
+
+#include "quantum.h"
+
+uint8_t keymap_layer_count(void);
@@ -0,0 +1,56 @@
+// QMK's steno keycodes, GeminiPR order.
+#pragma once
+
+#include "keycodes.h"
+
+enum steno_keycodes {
+    STN__MIN = QK_STENO,
+    STN_FN   = STN__MIN,
+    STN_NUM,
+    STN_N1 = STN_NUM,
+    STN_N2,
+    STN_N3,
+    STN_N4,
+    STN_N5,
+    STN_N6,
+    STN_SL,
+    STN_S1 = STN_SL,
+    STN_S2,
+    STN_TL,
+    STN_KL,
+    STN_PL,
+    STN_WL,
+    STN_HL,
+    STN_RL,
+    STN_A,
+    STN_O,
+    STN_STR,
+    STN_ST1 = STN_STR,
+    STN_ST2,
+    STN_RES1,
+    STN_RE1 = STN_RES1,
+    STN_RES2,
+    STN_RE2 = STN_RES2,
+    STN_PWR,
+    STN_ST3,
+    STN_ST4,
+    STN_E,
+    STN_U,
+    STN_FR,
+    STN_RR,
+    STN_PR,
+    STN_BR,
+    STN_LR,
+    STN_GR,
+    STN_TR,
+    STN_SR,
+    STN_DR,
+    STN_N7,
+    STN_N8,
+    STN_N9,
+    STN_NA,
+    STN_NB,
+    STN_NC,
+    STN_ZR,
+    STN__MAX = STN_ZR,
+};
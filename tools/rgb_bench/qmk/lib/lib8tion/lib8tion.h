@@ -0,0 +1,38 @@
+// The lib8tion helpers the features use, same results as QMK's.
+#pragma once
+
+#include <stdint.h>
+
+static inline uint8_t qadd8(uint8_t i, uint8_t j) {
+    const unsigned t = i + j;
+    return t > 255 ? 255 : t;
+}
+
+static inline uint8_t qsub8(uint8_t i, uint8_t j) {
+    return i > j ? i - j : 0;
+}
+
+static inline uint8_t scale8(uint8_t i, uint8_t scale) {
+    return ((uint16_t)i * (1 + (uint16_t)scale)) >> 8;
+}
+
+static inline uint8_t sqrt16(uint16_t x) {
+    if (x <= 1) {
+        return x;
+    }
+
+    uint8_t low = 1;
+    uint8_t hi  = x > 7904 ? 255 : (x >> 5) + 8;
+    do {
+        const uint16_t mid = (low + hi) >> 1;
+        if ((uint16_t)(mid * mid) > x) {
+            hi = mid - 1;
+        } else {
+            if (mid == 255) {
+                return 255;
+            }
+            low = mid + 1;
+        }
+    } while (hi >= low);
+    return low - 1;
+}
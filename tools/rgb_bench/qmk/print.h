@@ -0,0 +1,6 @@
+// Stand-in for QMK's print.h, the console goes nowhere on the bench.
+#pragma once
+
+#define print(s)
+#define uprintf(...)
+#define dprintf(...)
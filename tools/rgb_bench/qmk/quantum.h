@@ -0,0 +1,302 @@
+// Stand-in for QMK's quantum.h on the host, see tools/rgb_bench/Makefile.
+//
+// Declares the slice of the QMK API the keymaps and their features use; the
+// RGB matrix, layer and timer parts are implemented in host.c, everything
+// else is a no-op there.
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "bench_keyboard.h"
+#include "keycodes.h"
+#include "print.h"
+
+#define PROGMEM
+#define pgm_read_byte(address) (*(const uint8_t *)(address))
+#define pgm_read_word(address) (*(const uint16_t *)(address))
+#define pgm_read_dword(address) (*(const uint32_t *)(address))
+#define strcpy_P(dest, src) strcpy(dest, src)
+#define NO_LED 255
+#define MAX_LAYER 32
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof((a)[0]))
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+#define RGB_MATRIX_MAXIMUM_BRIGHTNESS 255
+
+// Timers, driven by the bench
+
+uint16_t timer_read(void);
+uint32_t timer_read32(void);
+uint16_t timer_elapsed(uint16_t last);
+uint32_t timer_elapsed32(uint32_t last);
+#define TIMER_DIFF_16(a, b) ((uint16_t)((a) - (b)))
+#define TIMER_DIFF_32(a, b) ((uint32_t)((a) - (b)))
+uint32_t last_input_activity_elapsed(void);
+uint32_t last_matrix_activity_elapsed(void);
+
+// Matrix and key events
+
+typedef uint32_t layer_state_t;
+typedef uint8_t matrix_row_t;
+
+typedef struct {
+    uint8_t col;
+    uint8_t row;
+} keypos_t;
+
+typedef struct {
+    keypos_t key;
+    uint16_t time;
+    uint8_t  type;
+    bool     pressed;
+} keyevent_t;
+
+typedef struct {
+    bool    interrupted : 1;
+    bool    reserved2 : 1;
+    bool    reserved1 : 1;
+    bool    reserved0 : 1;
+    uint8_t count : 4;
+} tap_t;
+
+typedef struct {
+    keyevent_t event;
+    tap_t      tap;
+    uint16_t   keycode;
+} keyrecord_t;
+
+matrix_row_t matrix_get_row(uint8_t row);
+void         action_exec(keyevent_t event);
+uint16_t     keymap_key_to_keycode(uint8_t layer, keypos_t key);
+
+// Layers
+
+extern layer_state_t layer_state;
+extern layer_state_t default_layer_state;
+uint8_t get_highest_layer(layer_state_t state);
+bool    layer_state_is(uint8_t layer);
+bool    layer_state_cmp(layer_state_t state, uint8_t layer);
+void    layer_on(uint8_t layer);
+void    layer_off(uint8_t layer);
+void    layer_move(uint8_t layer);
+void    layer_invert(uint8_t layer);
+void    layer_and(layer_state_t state);
+void    default_layer_set(layer_state_t state);
+
+// Keys and mods
+
+void    register_code(uint8_t code);
+void    unregister_code(uint8_t code);
+void    tap_code(uint8_t code);
+void    register_code16(uint16_t code);
+void    unregister_code16(uint16_t code);
+void    tap_code16(uint16_t code);
+uint8_t get_mods(void);
+uint8_t get_oneshot_mods(void);
+void    clear_oneshot_mods(void);
+void    clear_mods(void);
+void    set_mods(uint8_t mods);
+void    add_weak_mods(uint8_t mods);
+void    clear_weak_mods(void);
+void    del_weak_mods(uint8_t mods);
+void    send_char(char ascii_code);
+extern const uint8_t ascii_to_keycode_lut[128];
+extern const uint8_t ascii_to_shift_lut[16];
+void    send_keyboard_report(void);
+void    add_key(uint8_t key);
+void    del_key(uint8_t key);
+void    add_mods(uint8_t mods);
+void    del_mods(uint8_t mods);
+uint8_t get_oneshot_layer(void);
+void    reset_oneshot_layer(void);
+bool    is_caps_word_on(void);
+void    caps_word_on(void);
+void    caps_word_off(void);
+bool    get_auto_shifted_key(uint16_t keycode, keyrecord_t *record);
+
+typedef union {
+    uint16_t raw;
+    struct {
+        bool swap_control_capslock : 1;
+        bool capslock_to_control : 1;
+        bool swap_lalt_lgui : 1;
+        bool swap_ralt_rgui : 1;
+        bool no_gui : 1;
+        bool swap_grave_esc : 1;
+        bool swap_backslash_backspace : 1;
+        bool nkro : 1;
+    };
+} keymap_config_t;
+
+extern keymap_config_t keymap_config;
+
+// Keyboard reports, 6KRO only
+
+#define KEYBOARD_REPORT_KEYS 6
+
+typedef struct {
+    uint8_t mods;
+    uint8_t reserved;
+    uint8_t keys[KEYBOARD_REPORT_KEYS];
+} report_keyboard_t;
+
+// The report the next send_keyboard_report() sends
+extern report_keyboard_t *keyboard_report;
+
+// EECONFIG, nothing is kept between bench runs
+
+void eeconfig_read_user_datablock(void *data);
+void eeconfig_update_user_datablock(const void *data);
+
+// GPIO, no pins on the bench
+
+#define setPinOutput(pin)
+#define writePinHigh(pin)
+#define writePinLow(pin)
+
+// OLED, a 128x32 display with nothing drawn on the bench
+
+uint8_t oled_max_chars(void);
+uint8_t oled_max_lines(void);
+void    oled_clear(void);
+void    oled_set_cursor(uint8_t col, uint8_t line);
+void    oled_write_char(const char data, bool invert);
+
+// Split keyboard
+
+bool is_keyboard_master(void);
+bool is_keyboard_left(void);
+bool is_transport_connected(void);
+
+// Colours
+
+typedef struct {
+    uint8_t h;
+    uint8_t s;
+    uint8_t v;
+} HSV;
+
+typedef struct {
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+} RGB;
+
+#define HSV_AZURE 132, 102, 255
+#define HSV_GOLD 36, 255, 255
+#define HSV_GREEN 85, 255, 255
+#define HSV_PURPLE 191, 255, 255
+#define HSV_RED 0, 255, 255
+#define HSV_WHITE 0, 0, 255
+#define HSV_OFF 0, 0, 0
+
+RGB hsv_to_rgb(HSV hsv);
+
+// RGB matrix
+
+typedef struct {
+    uint8_t matrix_co[MATRIX_ROWS][MATRIX_COLS];
+    struct {
+        uint8_t x;
+        uint8_t y;
+    } point[RGB_MATRIX_LED_COUNT];
+    uint8_t flags[RGB_MATRIX_LED_COUNT];
+} led_config_t;
+
+extern led_config_t g_led_config;
+
+#define LED_FLAG_NONE 0x00
+#define LED_FLAG_ALL 0xFF
+#define LED_FLAG_MODIFIER 0x01
+#define LED_FLAG_UNDERGLOW 0x02
+#define LED_FLAG_KEYLIGHT 0x04
+#define LED_FLAG_INDICATOR 0x08
+#define HAS_FLAGS(bits, flags) (((bits) & (flags)) == (flags))
+#define HAS_ANY_FLAGS(bits, flags) ((bits) & (flags))
+
+typedef struct {
+    uint8_t iter;
+    uint8_t flags;
+    bool    init;
+} effect_params_t;
+
+// The bench changes the process limit and the half at run time, where QMK
+// fixes both at build time
+extern uint8_t rgb_matrix_led_process_limit;
+
+#ifdef RGB_MATRIX_SPLIT
+#    define _RGB_MATRIX_SPLIT_LIMITS(min, max)                                                   \
+        const uint8_t k_rgb_matrix_split[2] = RGB_MATRIX_SPLIT;                               \
+        if (is_keyboard_left() && (max > k_rgb_matrix_split[0])) max = k_rgb_matrix_split[0]; \
+        if (!(is_keyboard_left()) && (min < k_rgb_matrix_split[0])) min = k_rgb_matrix_split[0];
+#else
+#    define _RGB_MATRIX_SPLIT_LIMITS(min, max)
+#endif
+
+#define RGB_MATRIX_USE_LIMITS_ITER(min, max, iter)                                                           \
+    uint8_t min = rgb_matrix_led_process_limit ? rgb_matrix_led_process_limit * (iter) : 0;                 \
+    uint8_t max = rgb_matrix_led_process_limit ? min + rgb_matrix_led_process_limit : RGB_MATRIX_LED_COUNT; \
+    if (max > RGB_MATRIX_LED_COUNT) max = RGB_MATRIX_LED_COUNT;                                              \
+    _RGB_MATRIX_SPLIT_LIMITS(min, max)
+
+#define RGB_MATRIX_USE_LIMITS(min, max) RGB_MATRIX_USE_LIMITS_ITER(min, max, params->iter)
+
+#define RGB_MATRIX_TEST_LED_FLAGS() \
+    if (!HAS_ANY_FLAGS(g_led_config.flags[i], params->flags)) continue
+
+// Stock effects the bench stands in for, then the keymap's own like QMK
+// numbers them
+enum rgb_matrix_effects {
+    RGB_MATRIX_NONE = 0,
+    RGB_MATRIX_SOLID_COLOR,
+#ifdef RGB_MATRIX_CUSTOM_USER
+#    define RGB_MATRIX_EFFECT(name) RGB_MATRIX_CUSTOM_##name,
+#    include "rgb_matrix_user.inc"
+#    undef RGB_MATRIX_EFFECT
+#endif
+    RGB_MATRIX_EFFECT_MAX
+};
+
+bool    rgb_matrix_check_finished_leds(uint8_t led_idx);
+void    rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue);
+void    rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue);
+RGB     rgb_matrix_hsv_to_rgb(HSV hsv);
+bool    rgb_matrix_is_enabled(void);
+void    rgb_matrix_enable_noeeprom(void);
+void    rgb_matrix_disable_noeeprom(void);
+uint8_t rgb_matrix_get_mode(void);
+void    rgb_matrix_mode_noeeprom(uint8_t mode);
+uint8_t rgb_matrix_get_hue(void);
+uint8_t rgb_matrix_get_sat(void);
+uint8_t rgb_matrix_get_val(void);
+uint8_t rgb_matrix_get_speed(void);
+void    rgb_matrix_sethsv_noeeprom(uint8_t hue, uint8_t sat, uint8_t val);
+void    rgb_matrix_set_speed_noeeprom(uint8_t speed);
+void    rgb_matrix_reload_from_eeprom(void);
+
+extern uint32_t g_rgb_timer;
+
+// USB and debug
+
+enum usb_device_state {
+    USB_DEVICE_STATE_NO_INIT    = 0,
+    USB_DEVICE_STATE_INIT       = 1,
+    USB_DEVICE_STATE_CONFIGURED = 2,
+    USB_DEVICE_STATE_SUSPEND    = 3,
+};
+
+void virtser_send(const uint8_t byte);
+
+extern bool debug_enable;
+extern bool debug_matrix;
+extern bool debug_keyboard;
+extern bool debug_mouse;
+
+// OLED, for the keymaps that have one
+
+bool oled_on(void);
+bool oled_off(void);
+bool is_oled_on(void);
@@ -0,0 +1,4 @@
+// Stand-in for QMK's split_util.h, declared in quantum.h on the bench.
+#pragma once
+
+#include "quantum.h"
@@ -0,0 +1,20 @@
+// Stand-in for QMK's split transactions, user IDs come from the keymap's
+// SPLIT_TRANSACTION_IDS_USER like they do in QMK.
+#pragma once
+
+#include "quantum.h"
+
+enum serial_transaction_id {
+    GET_SLAVE_MATRIX_CHECKSUM = 0,
+#ifdef SPLIT_TRANSACTION_IDS_USER
+    SPLIT_TRANSACTION_IDS_USER,
+#endif
+    NUM_TOTAL_TRANSACTIONS
+};
+
+typedef void (*slave_callback_t)(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
+
+void transaction_register_rpc(int8_t transaction_id, slave_callback_t callback);
+bool transaction_rpc_send(int8_t transaction_id, uint8_t initiator2target_buffer_size, const void *initiator2target_buffer);
+bool transaction_rpc_recv(int8_t transaction_id, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
+bool transaction_rpc_exec(int8_t transaction_id, uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
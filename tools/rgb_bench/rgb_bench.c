@@ -0,0 +1,260 @@
+// Host benchmark for a keymap's RGB matrix code, see Makefile.
+//
+// Runs every effect in the keymap's rgb_matrix_user.inc, plus a solid colour
+// stand-in for the stock effects, through QMK's render loop with the keymap's
+// own indicator callbacks, on every layer, on each half of a split keyboard
+// and with a set of RGB_MATRIX_LED_PROCESS_LIMIT chunk sizes.  Each run types
+// the same pseudo-random keys at the same simulated times, so the frame
+// checksum only changes when the pixels do.  Times are host nanoseconds:
+// compare them with each other, not with the RP2040.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "quantum.h"
+#include "host.h"
+
+#define RGB_MATRIX_CUSTOM_EFFECT_IMPLS
+#define RGB_MATRIX_EFFECT(name)
+#include "rgb_matrix_user.inc"
+#undef RGB_MATRIX_EFFECT
+#undef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
+
+// QMK's default RGB_MATRIX_LED_FLUSH_LIMIT, one frame
+#define FRAME_MS 16
+
+// Keys held down at once and frames between presses
+#define TYPING_KEYS 3
+#define TYPING_EVERY 4
+
+// Stand-in for the stock effects so the indicators have a frame to draw on
+static bool solid_color(effect_params_t *params) {
+    RGB_MATRIX_USE_LIMITS(led_min, led_max);
+
+    const RGB rgb = rgb_matrix_hsv_to_rgb((HSV){rgb_matrix_get_hue(), rgb_matrix_get_sat(), rgb_matrix_get_val()});
+    for (uint8_t i = led_min; i < led_max; i++) {
+        RGB_MATRIX_TEST_LED_FLAGS();
+        rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
+    }
+    return rgb_matrix_check_finished_leds(led_max);
+}
+
+typedef struct {
+    const char *name;
+    uint8_t     mode;
+    bool (*render)(effect_params_t *params);
+} bench_effect_t;
+
+static const bench_effect_t effects[] = {
+    {"solid_color", RGB_MATRIX_SOLID_COLOR, solid_color},
+#define RGB_MATRIX_EFFECT(name) {#name, RGB_MATRIX_CUSTOM_##name, name},
+#include "rgb_matrix_user.inc"
+#undef RGB_MATRIX_EFFECT
+};
+
+typedef struct {
+    uint32_t frames;
+    uint32_t chunks;
+    uint64_t frame_ns;
+    uint64_t frame_max_ns;
+    uint64_t chunk_max_ns;
+    uint32_t checksum;
+} bench_result_t;
+
+static uint64_t _now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+// FNV-1a over the LED buffer
+static uint32_t _checksum(uint32_t hash) {
+    const uint8_t *bytes = (const uint8_t *)bench_leds;
+    for (size_t i = 0; i < sizeof(bench_leds); i++) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+// Presses and releases keys that have an LED, the same ones every run
+static void _type(uint32_t frame) {
+    static uint32_t    seed;
+    static keypos_t    held[TYPING_KEYS];
+    static const uint8_t none = 0xFF;
+
+    if (frame == 0) {
+        seed = 1;
+        memset(held, none, sizeof(held));
+    }
+    if (frame % TYPING_EVERY) {
+        return;
+    }
+
+    keypos_t *key = &held[(frame / TYPING_EVERY) % TYPING_KEYS];
+    if (key->row != none) {
+        bench_matrix[key->row] &= ~((matrix_row_t)1 << key->col);
+    }
+    do {
+        seed      = seed * 1103515245u + 12345u;
+        key->row  = (seed >> 16) % MATRIX_ROWS;
+        key->col  = (seed >> 8) % MATRIX_COLS;
+    } while (g_led_config.matrix_co[key->row][key->col] == NO_LED);
+    bench_matrix[key->row] |= (matrix_row_t)1 << key->col;
+}
+
+// rgb_matrix_indicators_advanced() gets the chunk the effect just rendered
+static void _indicators_advanced(effect_params_t *params) {
+    RGB_MATRIX_USE_LIMITS_ITER(min, max, params->iter - 1);
+    rgb_matrix_indicators_advanced_user(min, max);
+}
+
+// One frame the way rgb_matrix_task() renders it, returns the chunk count
+static uint8_t _render_frame(const bench_effect_t *effect, effect_params_t *params, bench_result_t *result) {
+    params->iter = 0;
+
+    bool rendering;
+    do {
+        const uint64_t start = _now_ns();
+
+        rendering = effect->render(params);
+        params->iter++;
+        if (!rendering) {
+            rgb_matrix_indicators_user();
+        }
+        _indicators_advanced(params);
+
+        const uint64_t took = _now_ns() - start;
+        result->frame_ns += took;
+        result->chunks++;
+        if (took > result->chunk_max_ns) {
+            result->chunk_max_ns = took;
+        }
+    } while (rendering);
+
+    params->init = false;
+    return params->iter;
+}
+
+static bench_result_t _run(const bench_effect_t *effect, uint8_t layer, uint32_t frames) {
+    bench_result_t  result = {.checksum = 2166136261u};
+    effect_params_t params = {.flags = LED_FLAG_ALL, .init = true};
+
+    rgb_matrix_mode_noeeprom(effect->mode);
+    layer_state = (layer_state_t)1 << layer;
+    memset(bench_matrix, 0, sizeof(bench_matrix));
+    memset(bench_leds, 0, sizeof(bench_leds));
+
+    for (uint32_t frame = 0; frame < frames; frame++) {
+        _type(frame);
+        matrix_scan_user();
+        housekeeping_task_user();
+
+        const uint64_t before = result.frame_ns;
+        _render_frame(effect, &params, &result);
+        if (result.frame_ns - before > result.frame_max_ns) {
+            result.frame_max_ns = result.frame_ns - before;
+        }
+
+        result.checksum = _checksum(result.checksum);
+        bench_time += FRAME_MS;
+        g_rgb_timer = bench_time;
+        result.frames++;
+    }
+    return result;
+}
+
+static void _usage(const char *name) {
+    fprintf(stderr,
+            "usage: %s [-n frames] [-e effect] [-l limit,limit,...]\n"
+            "  -n  frames per run (default 500)\n"
+            "  -e  only run this effect\n"
+            "  -l  RGB_MATRIX_LED_PROCESS_LIMIT values, 0 for none (default 0,8,16)\n",
+            name);
+    exit(2);
+}
+
+int main(int argc, char **argv) {
+    uint32_t    frames = 500;
+    const char *only   = NULL;
+    char        limits_arg[64] = "0,8,16";
+
+    int opt;
+    while ((opt = getopt(argc, argv, "n:e:l:")) != -1) {
+        switch (opt) {
+            case 'n':
+                frames = strtoul(optarg, NULL, 0);
+                break;
+            case 'e':
+                only = optarg;
+                break;
+            case 'l':
+                snprintf(limits_arg, sizeof(limits_arg), "%s", optarg);
+                break;
+            default:
+                _usage(argv[0]);
+        }
+    }
+
+    uint8_t limits[16];
+    uint8_t limit_count = 0;
+    for (char *token = strtok(limits_arg, ","); token && limit_count < ARRAY_SIZE(limits); token = strtok(NULL, ",")) {
+        limits[limit_count++] = strtoul(token, NULL, 0);
+    }
+
+    // Boot like the firmware does, deferred stages included
+    keyboard_pre_init_user();
+    keyboard_post_init_user();
+    for (uint32_t i = 0; i < 64; i++) {
+        housekeeping_task_user();
+        bench_time += 100;
+    }
+    rgb_matrix_enable_noeeprom();
+
+#ifdef SPLIT_KEYBOARD
+    const uint8_t sides = 2;
+#else
+    const uint8_t sides = 1;
+#endif
+
+    printf("%d LEDs, %u frames per run\n\n", RGB_MATRIX_LED_COUNT, (unsigned)frames);
+    printf("%-16s %5s %5s %5s %6s %10s %10s %10s %10s\n", "effect", "layer", "half", "limit", "chunks", "frame ns", "max ns",
+           "chunk ns", "checksum");
+
+    for (size_t e = 0; e < ARRAY_SIZE(effects); e++) {
+        if (only && strcmp(only, effects[e].name)) {
+            continue;
+        }
+        for (uint8_t layer = 0; layer < BENCH_LAYER_COUNT; layer++) {
+            for (uint8_t side = 0; side < sides; side++) {
+                for (uint8_t l = 0; l < limit_count; l++) {
+                    // Every run starts from the booted state
+                    fflush(stdout);
+                    const pid_t child = fork();
+                    if (child == 0) {
+                        bench_left                   = side == 0;
+                        rgb_matrix_led_process_limit = limits[l];
+
+                        const bench_result_t r = _run(&effects[e], layer, frames);
+                        printf("%-16s %5u %5s %5u %6.1f %10llu %10llu %10llu   %08x\n", effects[e].name, layer,
+                               side ? "right" : "left", limits[l], (double)r.chunks / r.frames,
+                               (unsigned long long)(r.frame_ns / r.frames), (unsigned long long)r.frame_max_ns,
+                               (unsigned long long)(r.frame_ns / r.chunks), (unsigned)r.checksum);
+                        fflush(stdout);
+                        _exit(0);
+                    }
+
+                    int status;
+                    waitpid(child, &status, 0);
+                    if (!WIFEXITED(status) || WEXITSTATUS(status)) {
+                        fprintf(stderr, "%s on layer %u failed\n", effects[e].name, layer);
+                        return 1;
+                    }
+                }
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,474 @@
+#!/usr/bin/env python3
+"""Runs the keymap model as a real Linux input device.
+
+Feeds key events through the latency_model.py model of a keymap in real time
+and sends what it types through /dev/uinput as a virtual keyboard and mouse,
+so layer lock, the swapper, one-shot modifiers and tap-hold timings can be
+tried out in any application on a developer machine, with no board attached.
+
+Input is either a recorded trace (the same formats latency_model.py reads)
+played back at its own pace, or a real keyboard grabbed through evdev.  A
+real keyboard needs --map, a JSON object from its evdev key names or codes
+to layout indexes of the keymap, { "KEY_Q": 13, "KEY_W": 14, ... }.
+
+Every keystroke that types something is timestamped at each stage:
+
+    input      the trace time, or the kernel timestamp of the evdev event
+    decided    when the model resolved it (tap-hold and auto shift wait here)
+    written    after the report was written to uinput
+    delivered  the kernel timestamp on the virtual device's own event node
+
+and the stage latencies are reported when the trace ends or on ctrl-c.
+
+    tools/uinput_host.py keyboards/bastardkb/scylla/keymaps/filbar-scylla \\
+        --trace trace.log --info scylla.json
+    sudo tools/uinput_host.py keyboards/splitkb/aurora/lily58/keymaps/filbar \\
+        --device /dev/input/event3 --map lily58-map.json
+
+Needs write access to /dev/uinput (and read access to the keyboard).  With
+--dry-run the events are printed instead.
+"""
+
+import argparse
+import collections
+import dataclasses
+import fcntl
+import json
+import os
+import select
+import statistics
+import struct
+import sys
+import time
+
+import latency_model
+
+# --------------------------------------------------------------------------
+# Linux input constants
+
+def _ioc(direction, kind, number, size):
+    return (direction << 30) | (size << 16) | (ord(kind) << 8) | number
+
+
+UI_DEV_CREATE = _ioc(0, 'U', 1, 0)
+UI_DEV_DESTROY = _ioc(0, 'U', 2, 0)
+UI_DEV_SETUP = _ioc(1, 'U', 3, 92)
+UI_SET_EVBIT = _ioc(1, 'U', 100, 4)
+UI_SET_KEYBIT = _ioc(1, 'U', 101, 4)
+UI_SET_RELBIT = _ioc(1, 'U', 102, 4)
+UI_GET_SYSNAME = _ioc(2, 'U', 44, 64)
+EVIOCGRAB = _ioc(1, 'E', 0x90, 4)
+EVIOCSCLOCKID = _ioc(1, 'E', 0xa0, 4)
+
+EV_SYN, EV_KEY, EV_REL = 0, 1, 2
+SYN_REPORT = 0
+REL_X, REL_Y, REL_HWHEEL, REL_WHEEL = 0, 1, 6, 8
+BUS_VIRTUAL = 0x06
+CLOCK_MONOTONIC = 1
+
+EVENT = struct.Struct('llHHi')
+
+# QMK keycode names (without KC_) to evdev key codes
+KEYS = {
+    'ESC': 1, 'ESCAPE': 1, '1': 2, '2': 3, '3': 4, '4': 5, '5': 6, '6': 7, '7': 8, '8': 9, '9': 10, '0': 11,
+    'MINS': 12, 'MINUS': 12, 'EQL': 13, 'EQUAL': 13, 'BSPC': 14, 'BACKSPACE': 14, 'TAB': 15,
+    'Q': 16, 'W': 17, 'E': 18, 'R': 19, 'T': 20, 'Y': 21, 'U': 22, 'I': 23, 'O': 24, 'P': 25,
+    'LBRC': 26, 'RBRC': 27, 'ENT': 28, 'ENTER': 28,
+    'A': 30, 'S': 31, 'D': 32, 'F': 33, 'G': 34, 'H': 35, 'J': 36, 'K': 37, 'L': 38,
+    'SCLN': 39, 'QUOT': 40, 'GRV': 41, 'BSLS': 43,
+    'Z': 44, 'X': 45, 'C': 46, 'V': 47, 'B': 48, 'N': 49, 'M': 50, 'COMM': 51, 'DOT': 52, 'SLSH': 53,
+    'SPC': 57, 'SPACE': 57, 'CAPS': 58,
+    'F1': 59, 'F2': 60, 'F3': 61, 'F4': 62, 'F5': 63, 'F6': 64, 'F7': 65, 'F8': 66, 'F9': 67, 'F10': 68,
+    'F11': 87, 'F12': 88,
+    'HOME': 102, 'UP': 103, 'PGUP': 104, 'LEFT': 105, 'RGHT': 106, 'RIGHT': 106, 'END': 107,
+    'DOWN': 108, 'PGDN': 109, 'INS': 110, 'DEL': 111,
+    'MUTE': 113, 'VOLD': 114, 'VOLU': 115, 'MNXT': 163, 'MPLY': 164, 'MPRV': 165, 'BRID': 224, 'BRIU': 225,
+}
+MODS = {'C': 29, 'S': 42, 'A': 56, 'G': 125}
+BUTTONS = {'BTN1': 0x110, 'BTN2': 0x111, 'BTN3': 0x112, 'BTN4': 0x113, 'BTN5': 0x114}
+for _button in list(BUTTONS):
+    BUTTONS['MS_' + _button] = BUTTONS[_button]
+
+# Mouse keys at a constant speed, no acceleration
+MOUSE_INTERVAL = 20
+WHEEL_INTERVAL = 80
+MOUSE = {
+    'MS_U': (REL_Y, -8, MOUSE_INTERVAL), 'MS_D': (REL_Y, 8, MOUSE_INTERVAL),
+    'MS_L': (REL_X, -8, MOUSE_INTERVAL), 'MS_R': (REL_X, 8, MOUSE_INTERVAL),
+    'MS_UP': (REL_Y, -8, MOUSE_INTERVAL), 'MS_DOWN': (REL_Y, 8, MOUSE_INTERVAL),
+    'MS_LEFT': (REL_X, -8, MOUSE_INTERVAL), 'MS_RGHT': (REL_X, 8, MOUSE_INTERVAL),
+    'WH_U': (REL_WHEEL, 1, WHEEL_INTERVAL), 'WH_D': (REL_WHEEL, -1, WHEEL_INTERVAL),
+    'WH_L': (REL_HWHEEL, -1, WHEEL_INTERVAL), 'WH_R': (REL_HWHEEL, 1, WHEEL_INTERVAL),
+}
+
+# Custom keycodes handled by update_swapper() in the keymaps: trigger -> tabish
+SWAPPERS = {'SW_APP': 'TAB', 'SW_WIN': 'GRV'}
+
+# Keys that do not end a swap, the keymaps' is_swapper_ignored_key()
+SWAPPER_IGNORED = {'OS_SHFT'}
+
+NAMES = {code: name for name, code in KEYS.items()}
+NAMES.update({code: 'L' + mod for mod, code in MODS.items()})
+NAMES.update({code: name for name, code in BUTTONS.items()})
+
+
+# --------------------------------------------------------------------------
+# Devices
+
+class VirtualDevice:
+    """The uinput keyboard and mouse, and its own event node for readback."""
+
+    def __init__(self, clock, dry_run):
+        self.clock = clock
+        self.fd = None
+        self.readback = None
+        if dry_run:
+            return
+
+        self.fd = os.open('/dev/uinput', os.O_WRONLY | os.O_NONBLOCK)
+        for kind in (EV_SYN, EV_KEY, EV_REL):
+            fcntl.ioctl(self.fd, UI_SET_EVBIT, kind)
+        for code in set(KEYS.values()) | set(MODS.values()) | set(BUTTONS.values()):
+            fcntl.ioctl(self.fd, UI_SET_KEYBIT, code)
+        for code in (REL_X, REL_Y, REL_WHEEL, REL_HWHEEL):
+            fcntl.ioctl(self.fd, UI_SET_RELBIT, code)
+        fcntl.ioctl(self.fd, UI_DEV_SETUP, struct.pack('HHHH80sI', BUS_VIRTUAL, 0xfeed, 0x0001, 1,
+                                                       b'filbar keymap model', 0))
+        fcntl.ioctl(self.fd, UI_DEV_CREATE)
+
+        sysname = bytearray(64)
+        fcntl.ioctl(self.fd, UI_GET_SYSNAME, sysname)
+        sysdir = '/sys/devices/virtual/input/' + sysname.split(b'\0')[0].decode()
+        for _ in range(100):
+            nodes = [n for n in os.listdir(sysdir) if n.startswith('event')] if os.path.isdir(sysdir) else []
+            if nodes and os.path.exists('/dev/input/' + nodes[0]):
+                try:
+                    self.readback = os.open('/dev/input/' + nodes[0], os.O_RDONLY | os.O_NONBLOCK)
+                    fcntl.ioctl(self.readback, EVIOCSCLOCKID, CLOCK_MONOTONIC)
+                    break
+                except PermissionError:
+                    print('no read access to /dev/input/%s, not measuring delivery' % nodes[0], file=sys.stderr)
+                    break
+            time.sleep(0.01)
+
+    def write(self, events):
+        """Writes (type, code, value) events and a SYN_REPORT, returns the time after the write."""
+        events = list(events) + [(EV_SYN, SYN_REPORT, 0)]
+        if self.fd is None:
+            now = self.clock()
+            for kind, code, value in events[:-1]:
+                name = NAMES.get(code, str(code)) if kind == EV_KEY else 'REL_%d' % code
+                print('%10.3f %-8s %d' % (now, name, value))
+            return now
+        os.write(self.fd, b''.join(EVENT.pack(0, 0, kind, code, value) for kind, code, value in events))
+        return self.clock()
+
+    def read_delivered(self):
+        """(time, code) of the key presses that came out of the virtual device."""
+        delivered = []
+        while True:
+            try:
+                data = os.read(self.readback, EVENT.size * 64)
+            except BlockingIOError:
+                return delivered
+            for offset in range(0, len(data), EVENT.size):
+                sec, usec, kind, code, value = EVENT.unpack_from(data, offset)
+                if kind == EV_KEY and value == 1:
+                    delivered.append((self.clock.at(sec + usec / 1e6), code))
+
+    def close(self):
+        if self.readback is not None:
+            os.close(self.readback)
+        if self.fd is not None:
+            fcntl.ioctl(self.fd, UI_DEV_DESTROY)
+            os.close(self.fd)
+
+
+class Clock:
+    """Milliseconds on CLOCK_MONOTONIC since the start of the run."""
+
+    def __init__(self):
+        self.start = time.monotonic()
+
+    def __call__(self):
+        return (time.monotonic() - self.start) * 1000
+
+    def at(self, seconds):
+        return (seconds - self.start) * 1000
+
+
+# --------------------------------------------------------------------------
+# Model
+
+@dataclasses.dataclass
+class Stages:
+    keystroke: latency_model.Keystroke
+    input: float
+    decided: float
+    written: float
+    delivered: float = None
+
+
+class HostModel(latency_model.Model):
+    """The keymap model with its output sent to a VirtualDevice."""
+
+    def __init__(self, keymap, config, device):
+        super().__init__(keymap, config)
+        self.device = device
+        self.sent_mods = set()
+        self.swappers = {name: False for name in SWAPPERS}
+        self.down = {}               # keystroke index -> (event code, mods sent with it)
+        self.mouse = {}              # keystroke index -> [axis, step, interval, next time]
+        self.stages = []
+        self.undelivered = collections.deque()
+
+    def wanted_mods(self):
+        mods = {mod for mod, count in self.mods.items() if count > 0}
+        if any(self.swappers.values()):
+            mods.add('G')
+        return mods
+
+    def sync_mods(self, extra=frozenset()):
+        wanted = self.wanted_mods() | set(extra)
+        events = [(EV_KEY, MODS[m], 1) for m in sorted(wanted - self.sent_mods)]
+        events += [(EV_KEY, MODS[m], 0) for m in sorted(self.sent_mods - wanted)]
+        self.sent_mods = wanted
+        if events:
+            self.device.write(events)
+
+    # Output
+
+    def emit(self, time, keystroke, shifted=False):
+        super().emit(time, keystroke, shifted)
+        key = keystroke.key
+
+        if key.name in MOUSE:
+            axis, step, interval = MOUSE[key.name]
+            self.mouse[keystroke.index] = [axis, step, interval, time]
+            self.tick(time)
+            return
+        code = KEYS.get(key.name) or BUTTONS.get(key.name)
+        if key.kind == 'other' or code is None:
+            return
+
+        extra = set(key.mods) | ({'S'} if shifted else set())
+        self.sync_mods(extra)
+        written = self.device.write([(EV_KEY, code, 1)])
+        stages = Stages(keystroke, keystroke.pressed_at, time, written)
+        self.stages.append(stages)
+        if self.device.readback is not None:
+            self.undelivered.append((code, stages))
+
+        # Plain keys stay down while held, taps and auto shifts come out whole
+        still_held = any(k is keystroke for k, _ in self.held.values())
+        if keystroke.resolution == 'plain' and still_held:
+            self.down[keystroke.index] = (code, extra)
+        else:
+            self.device.write([(EV_KEY, code, 0)])
+            self.sync_mods()
+
+    def swapper(self, key, pressed):
+        """update_swapper() for each swapper, in keymap order."""
+        for trigger, tabish in SWAPPERS.items():
+            if key.kind == 'other' and key.name == trigger:
+                if pressed:
+                    self.swappers[trigger] = True
+                    self.sync_mods()
+                self.device.write([(EV_KEY, KEYS[tabish], 1 if pressed else 0)])
+            elif self.swappers[trigger] and key.name not in SWAPPER_IGNORED:
+                self.swappers[trigger] = False
+                self.sync_mods()
+
+    # Events
+
+    def press(self, now, index, pressed_at):
+        self.swapper(self.resolve(index), True)
+        super().press(now, index, pressed_at)
+
+    def release(self, now, index):
+        if index not in self.held:
+            return
+        keystroke, _ = self.held[index]
+        self.swapper(keystroke.key, False)
+        self.mouse.pop(keystroke.index, None)
+        if keystroke.index in self.down:
+            code, _ = self.down.pop(keystroke.index)
+            self.device.write([(EV_KEY, code, 0)])
+        super().release(now, index)
+
+    def step(self, now, index, down, pressed_at):
+        self.advance(now)
+        self.handle(now, index, down, pressed_at)
+        self.sync_mods()
+
+    def tick(self, now):
+        self.advance(now)
+        for move in self.mouse.values():
+            axis, step, interval, due = move
+            while due <= now:
+                self.device.write([(EV_REL, axis, step)])
+                due += interval
+            move[3] = due
+        self.sync_mods()
+
+    def next_wakeup(self):
+        times = [move[3] for move in self.mouse.values()]
+        if (due := self.deadline()):
+            times.append(due[0])
+        return min(times, default=None)
+
+    def delivered(self, events):
+        for time, code in events:
+            for i, (pending, stages) in enumerate(self.undelivered):
+                if pending == code:
+                    stages.delivered = time
+                    del self.undelivered[i]
+                    break
+
+
+# --------------------------------------------------------------------------
+# Inputs
+
+def trace_events(args, keymap):
+    events = latency_model.parse_trace(args.trace, keymap, args.info)
+    if not events:
+        sys.exit('no key events in %s' % args.trace)
+    first = events[0][0]
+    return collections.deque((args.lead_in + (t - first) / args.speed, index, down) for t, index, down in events)
+
+
+def open_keyboard(args):
+    mapping = {}
+    for name, index in json.load(open(args.map)).items():
+        code = int(name, 0) if name[0].isdigit() else \
+            {('KEY_' + k): v for k, v in KEYS.items()}.get(name) or \
+            {'KEY_LEFTCTRL': 29, 'KEY_LEFTSHIFT': 42, 'KEY_LEFTALT': 56, 'KEY_LEFTMETA': 125,
+             'KEY_RIGHTCTRL': 97, 'KEY_RIGHTSHIFT': 54, 'KEY_RIGHTALT': 100, 'KEY_RIGHTMETA': 126,
+             'KEY_BACKSPACE': 14, 'KEY_SEMICOLON': 39, 'KEY_APOSTROPHE': 40, 'KEY_GRAVE': 41,
+             'KEY_COMMA': 51, 'KEY_SLASH': 53, 'KEY_BACKSLASH': 43, 'KEY_LEFTBRACE': 26,
+             'KEY_RIGHTBRACE': 27, 'KEY_CAPSLOCK': 58, 'KEY_DELETE': 111, 'KEY_PAGEUP': 104,
+             'KEY_PAGEDOWN': 109}.get(name)
+        if code is None:
+            sys.exit('unknown key %s in %s' % (name, args.map))
+        mapping[code] = index
+
+    fd = os.open(args.device, os.O_RDONLY | os.O_NONBLOCK)
+    fcntl.ioctl(fd, EVIOCSCLOCKID, CLOCK_MONOTONIC)
+    fcntl.ioctl(fd, EVIOCGRAB, 1)
+    return fd, mapping
+
+
+def read_keyboard(fd, mapping, clock):
+    events = []
+    while True:
+        try:
+            data = os.read(fd, EVENT.size * 64)
+        except BlockingIOError:
+            return events
+        for offset in range(0, len(data), EVENT.size):
+            sec, usec, kind, code, value = EVENT.unpack_from(data, offset)
+            # value 2 is autorepeat, the model does its own
+            if kind == EV_KEY and value in (0, 1) and code in mapping:
+                events.append((clock.at(sec + usec / 1e6), mapping[code], value == 1))
+
+
+# --------------------------------------------------------------------------
+# Report
+
+def report(model):
+    def line(label, values):
+        if not values:
+            return '%-22s %6s' % (label, '-')
+        ordered = sorted(values)
+        return '%-22s %6d %8.2f %8.2f %8.2f %8.2f' % (
+            label, len(values), statistics.mean(values), ordered[len(ordered) // 2],
+            ordered[min(len(ordered) - 1, int(0.95 * len(ordered)))], ordered[-1])
+
+    stages = model.stages
+    print('\n%-22s %6s %8s %8s %8s %8s' % ('latency ms', 'keys', 'mean', 'p50', 'p95', 'max'))
+    print(line('input -> decided', [s.decided - s.input for s in stages]))
+    print(line('decided -> written', [s.written - s.decided for s in stages]))
+    delivered = [s for s in stages if s.delivered is not None]
+    print(line('written -> delivered', [s.delivered - s.written for s in delivered]))
+    print(line('input -> delivered', [s.delivered - s.input for s in delivered]))
+
+    print()
+    by_resolution = collections.defaultdict(list)
+    for s in stages:
+        by_resolution[s.keystroke.resolution].append((s.delivered if s.delivered is not None else s.written) - s.input)
+    for resolution, values in sorted(by_resolution.items()):
+        print(line(resolution, values))
+
+    text = ''.join(t for t, _ in latency_model.final_text(model.output))
+    print('\ntyped: %r' % text)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n\n')[0])
+    parser.add_argument('keymap', help='keymap directory (keymap.c, config.h, rules.mk)')
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument('--trace', help='trace to play back, as read by latency_model.py')
+    source.add_argument('--device', help='evdev keyboard to grab, /dev/input/eventN')
+    parser.add_argument('--info', help='keyboard.json / info.json for TRACE: lines')
+    parser.add_argument('--map', help='JSON map of evdev key names or codes to layout indexes, for --device')
+    parser.add_argument('--config', metavar='NAME:KEY=VALUE,...',
+                        help='timings to run with instead of the keymap ones, as in latency_model.py')
+    parser.add_argument('--speed', type=float, default=1.0, help='trace playback speed')
+    parser.add_argument('--lead-in', type=float, default=500, help='ms before the first trace event')
+    parser.add_argument('--dry-run', action='store_true', help='print events instead of using /dev/uinput')
+    args = parser.parse_args()
+    if args.device and not args.map:
+        parser.error('--device needs --map')
+
+    keymap = latency_model.parse_keymap(args.keymap)
+    config = latency_model.keymap_config(args.keymap)
+    if args.config:
+        config = latency_model.config_from_spec(config, args.config)
+
+    clock = Clock()
+    script = trace_events(args, keymap) if args.trace else None
+    keyboard, mapping = open_keyboard(args) if args.device else (None, None)
+    device = VirtualDevice(clock, args.dry_run)
+    model = HostModel(keymap, config, device)
+    print('%s, %s' % (keymap.layout, config.describe()), file=sys.stderr)
+
+    try:
+        while True:
+            now = clock()
+            wakeups = [w for w in (model.next_wakeup(), script[0][0] if script else None) if w is not None]
+            if script is not None and not script and model.deadline() is None and not model.undelivered:
+                break
+            timeout = max(0, min(wakeups) - now) / 1000 if wakeups else None
+            if script is not None and not script:
+                timeout = min(timeout if timeout is not None else 1, 1)
+
+            fds = [fd for fd in (keyboard, device.readback) if fd is not None]
+            ready, _, _ = select.select(fds, [], [], timeout)
+            if device.readback in ready:
+                model.delivered(device.read_delivered())
+            if keyboard is not None and keyboard in ready:
+                for at, index, down in read_keyboard(keyboard, mapping, clock):
+                    model.step(clock(), index, down, at)
+
+            now = clock()
+            while script and script[0][0] <= now:
+                at, index, down = script.popleft()
+                model.step(now, index, down, at)
+            model.tick(now)
+
+            # Nothing more is coming out of the kernel a second after the trace
+            if script is not None and not script and model.undelivered and now - model.stages[-1].written > 1000:
+                break
+    except KeyboardInterrupt:
+        pass
+    finally:
+        device.close()
+        if keyboard is not None:
+            fcntl.ioctl(keyboard, EVIOCGRAB, 0)
+            os.close(keyboard)
+
+    report(model)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,109 @@
+#include "boot_profile.h"
+#include "timer_us.h"
+
+#ifdef SPLIT_KEYBOARD
+#   include "split_util.h"
+#endif // SPLIT_KEYBOARD
+
+#ifdef CONSOLE_ENABLE
+#   include "print.h"
+#endif // CONSOLE_ENABLE
+
+static const char *const phase_names[BOOT_PHASE_COUNT] = {
+    [BOOT_PRE_INIT]        = "pre_init",
+    [BOOT_POST_INIT]       = "post_init",
+    [BOOT_FIRST_SCAN]      = "first scan",
+    [BOOT_SPLIT_CONNECTED] = "split connected",
+    [BOOT_USB_CONFIGURED]  = "usb configured",
+    [BOOT_INPUT_READY]     = "input ready",
+    [BOOT_DEFERRED_DONE]   = "deferred init",
+    [BOOT_FIRST_REPORT]    = "first report",
+};
+
+static uint32_t phase_at[BOOT_PHASE_COUNT];
+static bool     usb_configured = false;
+
+// Wake and replug tracking, times in us from the wake itself
+static uint32_t woke_at;
+static bool     waiting_for_ready;
+static bool     waiting_for_report;
+static uint16_t wake_count;
+static uint32_t last_wake_to_ready;
+static uint32_t last_wake_to_report;
+
+void boot_profile_mark(uint8_t phase) {
+    if (phase < BOOT_PHASE_COUNT && phase_at[phase] == 0) {
+        // 0 means unreached, a phase at exactly 0us is close enough to 1
+        phase_at[phase] = MAX(timer_read_us(), 1);
+    }
+}
+
+uint32_t boot_profile_get(uint8_t phase) {
+    return phase < BOOT_PHASE_COUNT ? phase_at[phase] : 0;
+}
+
+void boot_profile_task(void) {
+    boot_profile_mark(BOOT_FIRST_SCAN);
+
+#ifdef SPLIT_KEYBOARD
+    if (is_transport_connected()) {
+        boot_profile_mark(BOOT_SPLIT_CONNECTED);
+    }
+#endif // SPLIT_KEYBOARD
+
+    if (usb_configured) {
+        boot_profile_mark(BOOT_INPUT_READY);
+
+        if (waiting_for_ready) {
+            last_wake_to_ready = timer_elapsed_us(woke_at);
+            waiting_for_ready  = false;
+        }
+    }
+}
+
+void boot_profile_usb_state(bool configured) {
+    // Configured again after boot means the cable was replugged
+    if (configured && !usb_configured && phase_at[BOOT_USB_CONFIGURED] != 0 && !waiting_for_ready) {
+        boot_profile_wake();
+    }
+
+    if (configured) {
+        boot_profile_mark(BOOT_USB_CONFIGURED);
+    }
+    usb_configured = configured;
+}
+
+void boot_profile_wake(void) {
+    woke_at            = timer_read_us();
+    waiting_for_ready  = true;
+    waiting_for_report = true;
+    wake_count++;
+}
+
+void boot_profile_report_sent(void) {
+    boot_profile_mark(BOOT_FIRST_REPORT);
+
+    if (waiting_for_report) {
+        last_wake_to_report = timer_elapsed_us(woke_at);
+        waiting_for_report  = false;
+    }
+}
+
+void boot_profile_print(void) {
+#ifdef CONSOLE_ENABLE
+    uint32_t previous = 0;
+    for (uint8_t phase = 0; phase < BOOT_PHASE_COUNT; phase++) {
+        if (phase_at[phase] == 0) {
+            uprintf("BOOT: %-16s -\n", phase_names[phase]);
+            continue;
+        }
+
+        uprintf("BOOT: %-16s %8luus (+%lu)\n", phase_names[phase], (unsigned long)phase_at[phase], (unsigned long)(phase_at[phase] - MIN(previous, phase_at[phase])));
+        previous = phase_at[phase];
+    }
+
+    if (wake_count) {
+        uprintf("BOOT: %u wakes, last ready after %luus, report after %luus\n", wake_count, (unsigned long)last_wake_to_ready, (unsigned long)last_wake_to_report);
+    }
+#endif // CONSOLE_ENABLE
+}
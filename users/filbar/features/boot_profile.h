@@ -0,0 +1,54 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Boot phase timestamps.
+//
+// Each phase records the first time it is reached, in microseconds since
+// reset.  The keymap marks the init hooks itself; boot_profile_task(), called
+// from housekeeping_task_user(), picks up the first scan, the split link
+// coming up and input becoming ready (the first scan after USB is
+// configured).  boot_profile_report_sent() is fed from the report hook.
+//
+// After a wake from suspend or a USB replug the time until input is ready and
+// until the next report is measured again, see boot_profile_wake().
+//
+// Enable with `BOOT_PROFILE_ENABLE = yes` in rules.mk.
+
+enum boot_phases {
+    BOOT_PRE_INIT = 0,
+    BOOT_POST_INIT,
+    BOOT_FIRST_SCAN,
+    BOOT_SPLIT_CONNECTED,
+    BOOT_USB_CONFIGURED,
+    BOOT_INPUT_READY,
+    BOOT_DEFERRED_DONE,
+    BOOT_FIRST_REPORT,
+    BOOT_PHASE_COUNT
+};
+
+#ifdef BOOT_PROFILE_ENABLE
+
+void boot_profile_mark(uint8_t phase);
+void boot_profile_task(void);
+
+// USB device state changes, wakes from suspend and outgoing reports.
+void boot_profile_usb_state(bool configured);
+void boot_profile_wake(void);
+void boot_profile_report_sent(void);
+
+// Time a phase was first reached in us since reset, 0 if it has not been.
+uint32_t boot_profile_get(uint8_t phase);
+
+void boot_profile_print(void);
+
+#else
+
+static inline void boot_profile_mark(uint8_t phase) {}
+static inline void boot_profile_task(void) {}
+static inline void boot_profile_usb_state(bool configured) {}
+static inline void boot_profile_wake(void) {}
+static inline void boot_profile_report_sent(void) {}
+static inline void boot_profile_print(void) {}
+
+#endif // BOOT_PROFILE_ENABLE
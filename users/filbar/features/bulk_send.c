@@ -0,0 +1,130 @@
+#include "bulk_send.h"
+
+// Keys for the next report, and the keys the host has down right now
+static uint8_t batch[BULK_SEND_KEYS];
+static uint8_t batch_count;
+static bool    batch_shifted;
+static uint8_t sent[BULK_SEND_KEYS];
+static uint8_t sent_count;
+
+static bool contains(const uint8_t *keys, uint8_t count, uint8_t keycode) {
+    for (uint8_t i = 0; i < count; i++) {
+        if (keys[i] == keycode) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void send_report(void) {
+    send_keyboard_report();
+#if BULK_SEND_DELAY > 0
+    wait_ms(BULK_SEND_DELAY);
+#endif
+}
+
+static void send_batch(void) {
+    for (uint8_t i = 0; i < sent_count; i++) {
+        del_key(sent[i]);
+    }
+    if (batch_shifted) {
+        add_weak_mods(MOD_BIT(KC_LEFT_SHIFT));
+    } else {
+        del_weak_mods(MOD_BIT(KC_LEFT_SHIFT));
+    }
+    for (uint8_t i = 0; i < batch_count; i++) {
+        add_key(batch[i]);
+    }
+    send_report();
+
+    memcpy(sent, batch, batch_count);
+    sent_count  = batch_count;
+    batch_count = 0;
+}
+
+static void release(void) {
+    for (uint8_t i = 0; i < sent_count; i++) {
+        del_key(sent[i]);
+    }
+    send_report();
+    sent_count = 0;
+}
+
+// 6KRO slots taken by keys the rest of the keyboard is holding
+static uint8_t held_slots(void) {
+#ifdef NKRO_ENABLE
+    if (keymap_config.nkro) {
+        return 0;
+    }
+#endif // NKRO_ENABLE
+    uint8_t held = 0;
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        const uint8_t key = keyboard_report->keys[i];
+        if (key && !contains(sent, sent_count, key)) {
+            held++;
+        }
+    }
+    return held;
+}
+
+// Whether the host would see keycode typed after the batch if it joined it
+static bool fits(uint8_t keycode, bool shifted) {
+    if (batch_count == BULK_SEND_KEYS || shifted != batch_shifted) {
+        return false;
+    }
+    // add_key() drops what does not fit in the report
+    if (batch_count + held_slots() >= KEYBOARD_REPORT_KEYS) {
+        return false;
+    }
+    if (contains(batch, batch_count, keycode) || contains(sent, sent_count, keycode)) {
+        return false;
+    }
+#ifdef NKRO_ENABLE
+    if (keymap_config.nkro && keycode < batch[batch_count - 1]) {
+        return false;
+    }
+#endif // NKRO_ENABLE
+    return true;
+}
+
+void bulk_send_key(uint8_t keycode, bool shifted) {
+    if (batch_count && !fits(keycode, shifted)) {
+        send_batch();
+    }
+    if (!batch_count) {
+        // Down in the last report, the host needs to see it go up first
+        if (contains(sent, sent_count, keycode)) {
+            release();
+        }
+        batch_shifted = shifted;
+    }
+    batch[batch_count++] = keycode;
+}
+
+void bulk_send_char(char ascii) {
+    if ((uint8_t)ascii >= 128) {
+        return;
+    }
+    const uint8_t keycode = pgm_read_byte(&ascii_to_keycode_lut[(uint8_t)ascii]);
+    const bool    shifted = pgm_read_byte(&ascii_to_shift_lut[(uint8_t)ascii / 8]) & (0x80 >> ((uint8_t)ascii % 8));
+    if (keycode) {
+        bulk_send_key(keycode, shifted);
+    }
+}
+
+void bulk_send_string(const char *str) {
+    for (; *str; str++) {
+        bulk_send_char(*str);
+    }
+}
+
+void bulk_send_flush(void) {
+    if (!batch_count && !sent_count) {
+        return;
+    }
+    if (batch_count) {
+        send_batch();
+    }
+    del_weak_mods(MOD_BIT(KC_LEFT_SHIFT));
+    release();
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Bulk key sender, for text the keyboard types by itself.
+//
+// send_string() sends a press and a release report for every character.  A
+// host takes the changes in a report in a fixed order: modifiers first, then
+// the keys that went up, then the new keys in the order they appear in the
+// report (in usage order for NKRO).  So one report can carry the release of
+// the previous characters, a shift change and the next few characters, as
+// long as
+//
+//   - they all want the same shift state,
+//   - no key appears twice, or was already down in the report before, which
+//     the host would not see as a new press, and
+//   - with NKRO, their keycodes go up in the order they are typed.
+//
+// Keys are collected into a report until the next one breaks one of those,
+// or the report has no free slot left (keys the user is still holding take
+// theirs too), then the report is sent.  A key that repeats straight after itself gets
+// an all-released report first; that is the only release sent on its own.
+// Typing the same text takes about 1/BULK_SEND_KEYS of the reports
+// send_string() does, and with BULK_SEND_KEYS 1 still half of them.
+//
+// Queue taps with bulk_send_key(), bulk_send_char() or bulk_send_string(),
+// then call bulk_send_flush() to send what is left and let go of every key.
+// Shift is sent as a weak mod, other held mods are left to the caller.
+
+// Keys pressed per report, lower it for a host that does not take a
+// report's keys in order
+#ifndef BULK_SEND_KEYS
+#    define BULK_SEND_KEYS KEYBOARD_REPORT_KEYS
+#endif
+
+// Milliseconds between reports
+#ifndef BULK_SEND_DELAY
+#    define BULK_SEND_DELAY 0
+#endif
+
+void bulk_send_key(uint8_t keycode, bool shifted);
+void bulk_send_char(char ascii);
+void bulk_send_string(const char *str);
+void bulk_send_flush(void);
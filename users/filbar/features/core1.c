@@ -0,0 +1,69 @@
+#include "core1.h"
+
+#if !defined(MCU_RP)
+#    error "CORE1_ENABLE needs an RP2040"
+#endif
+
+#include "hardware/structs/psm.h"
+#include "hardware/structs/sio.h"
+
+static uint32_t stack[CORE1_STACK_SIZE / sizeof(uint32_t)];
+static bool     running = false;
+
+static void fifo_drain(void) {
+    while (sio_hw->fifo_st & SIO_FIFO_ST_VLD_BITS) {
+        (void)sio_hw->fifo_rd;
+    }
+}
+
+static void fifo_push(uint32_t value) {
+    while (!(sio_hw->fifo_st & SIO_FIFO_ST_RDY_BITS)) {
+    }
+    sio_hw->fifo_wr = value;
+    __SEV();
+}
+
+static uint32_t fifo_pop(void) {
+    while (!(sio_hw->fifo_st & SIO_FIFO_ST_VLD_BITS)) {
+        __WFE();
+    }
+    return sio_hw->fifo_rd;
+}
+
+void core1_launch(void (*entry)(void)) {
+    if (running) {
+        return;
+    }
+
+    // Back to the bootrom, in case a soft reset left it running something
+    psm_hw->frce_off |= PSM_FRCE_OFF_PROC1_BITS;
+    while (!(psm_hw->frce_off & PSM_FRCE_OFF_PROC1_BITS)) {
+    }
+    psm_hw->frce_off &= ~PSM_FRCE_OFF_PROC1_BITS;
+
+    // The bootrom echoes every word; a zero restarts the sequence
+    const uint32_t sequence[] = {
+        0,
+        0,
+        1,
+        SCB->VTOR,
+        (uintptr_t)&stack[ARRAY_SIZE(stack)],
+        (uintptr_t)entry,
+    };
+
+    uint8_t i = 0;
+    while (i < ARRAY_SIZE(sequence)) {
+        if (sequence[i] == 0) {
+            fifo_drain();
+            __SEV();
+        }
+        fifo_push(sequence[i]);
+        i = fifo_pop() == sequence[i] ? i + 1 : 0;
+    }
+
+    running = true;
+}
+
+bool core1_running(void) {
+    return running;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Second core of the RP2040.
+//
+// QMK and ChibiOS only ever run on core 0 and leave core 1 parked in the
+// bootrom.  core1_launch() hands it an entry point and a stack of its own
+// (CORE1_STACK_SIZE bytes) through the SIO FIFO, the same handshake the
+// bootrom expects from the Pico SDK.
+//
+// Anything core 1 runs has to be in RAM, which is what CORE1_RAMFUNC is for:
+// the EEPROM emulation erases and programs flash from core 0 every now and
+// then, and while it does neither core can fetch code or constant data from
+// flash.  That rules out calling into QMK or libc (memcpy, division helpers
+// and switch tables all live in flash), so keep core 1 code small and copy
+// whatever tables it needs into RAM before the launch.
+//
+// Core 1 has no interrupts enabled.  It can sleep in core1_wait() until core 0
+// calls core1_notify() after handing it work.
+//
+// Enable with `CORE1_ENABLE = yes` in rules.mk.
+
+#ifndef CORE1_STACK_SIZE
+#    define CORE1_STACK_SIZE 1024
+#endif
+
+// Also stops GCC from turning plain loops into memset()/memcpy() calls
+#define CORE1_RAMFUNC __attribute__((section(".ramtext.core1"), noinline, optimize("no-tree-loop-distribute-patterns")))
+
+#ifdef CORE1_ENABLE
+
+void core1_launch(void (*entry)(void));
+bool core1_running(void);
+
+static inline __attribute__((always_inline)) void core1_notify(void) {
+    __SEV();
+}
+
+static inline __attribute__((always_inline)) void core1_wait(void) {
+    __WFE();
+}
+
+#else
+
+static inline bool core1_running(void) {
+    return false;
+}
+
+#endif // CORE1_ENABLE
@@ -0,0 +1,54 @@
+#include "deferred_init.h"
+
+#ifdef SPLIT_KEYBOARD
+#   include "split_util.h"
+#endif // SPLIT_KEYBOARD
+
+static deferred_init_fn_t stages[DEFERRED_INIT_MAX_STAGES];
+static uint8_t            stage_count = 0;
+static uint8_t            next_stage  = 0;
+
+static bool usb_configured = false;
+static bool started        = false;
+
+bool deferred_init_add(deferred_init_fn_t fn) {
+    if (stage_count >= DEFERRED_INIT_MAX_STAGES) {
+        return false;
+    }
+    stages[stage_count++] = fn;
+    return true;
+}
+
+void deferred_init_usb_configured(void) {
+    usb_configured = true;
+}
+
+static bool ready(void) {
+    if (usb_configured || timer_read32() >= DEFERRED_INIT_TIMEOUT) {
+        return true;
+    }
+#ifdef SPLIT_KEYBOARD
+    if (!is_keyboard_master() && is_transport_connected()) {
+        return true;
+    }
+#endif // SPLIT_KEYBOARD
+    return false;
+}
+
+void deferred_init_task(void) {
+    if (next_stage >= stage_count) {
+        return;
+    }
+    if (!started) {
+        if (!ready()) {
+            return;
+        }
+        started = true;
+    }
+
+    stages[next_stage++]();
+}
+
+bool deferred_init_done(void) {
+    return next_stage >= stage_count;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Staged deferred initialisation.
+//
+// Work that is not needed to type, such as starting RGB effects or drawing
+// the OLED, is queued with deferred_init_add() from keyboard_post_init_user()
+// and run one stage per main loop iteration by deferred_init_task() once the
+// keyboard is usable:
+//
+//  * on the half connected to USB, once the host has configured the device
+//    (report that with deferred_init_usb_configured())
+//  * on the other half, once the split link is up
+//  * on either, after DEFERRED_INIT_TIMEOUT ms regardless, e.g. on a charger
+//
+// That keeps enumeration and the split handshake from competing with LED
+// rendering and I2C traffic.
+
+#ifndef DEFERRED_INIT_MAX_STAGES
+#    define DEFERRED_INIT_MAX_STAGES 8
+#endif
+
+#ifndef DEFERRED_INIT_TIMEOUT
+#    define DEFERRED_INIT_TIMEOUT 3000
+#endif
+
+typedef void (*deferred_init_fn_t)(void);
+
+// Queues a stage, returns false when the queue is full.
+bool deferred_init_add(deferred_init_fn_t fn);
+
+void deferred_init_usb_configured(void);
+void deferred_init_task(void);
+
+// True once every queued stage has run.
+bool deferred_init_done(void);
@@ -0,0 +1,405 @@
+#include "heatmap.h"
+#include "core1.h"
+#include "layer_tables.h"
+#include "lib/lib8tion/lib8tion.h"
+#include <string.h>
+
+#ifdef RGB_MATRIX_ENABLE
+
+// Heat per LED, padded to whole words so the decay can work on four at once
+#define HEAT_WORDS ((RGB_MATRIX_LED_COUNT + 3) / 4)
+
+static union {
+    uint32_t words[HEAT_WORDS];
+    uint8_t  leds[HEAT_WORDS * 4];
+} heat;
+
+// Closest first.  Boards with a generated table (LAYER_TABLE_HEAT_LEDS, see
+// tools/gen_layers.py) read it straight from flash, the others work theirs
+// out in _build_tables().  Core 1 must not touch flash, so with CORE1_ENABLE
+// the generated table is copied into RAM instead.
+#ifdef LAYER_TABLE_HEAT_LEDS
+_Static_assert(LAYER_TABLE_HEAT_LEDS == RGB_MATRIX_LED_COUNT, "RGB matrix changed, run tools/gen_layers.py");
+_Static_assert(LAYER_TABLE_HEAT_SPREAD == HEATMAP_SPREAD && LAYER_TABLE_HEAT_AREA_LIMIT == HEATMAP_AREA_LIMIT && LAYER_TABLE_HEAT_NEIGHBOURS == HEATMAP_MAX_NEIGHBOURS, "Heatmap settings changed, run tools/gen_layers.py");
+
+typedef layer_table_heat_t neighbour_t;
+#else
+typedef struct {
+    uint8_t led;
+    uint8_t weight;
+} neighbour_t;
+#endif // LAYER_TABLE_HEAT_LEDS
+
+#if defined(LAYER_TABLE_HEAT_LEDS) && !defined(CORE1_ENABLE)
+#    define neighbours layer_table_heat
+#    define neighbour_count layer_table_heat_count
+#else
+static neighbour_t neighbours[RGB_MATRIX_LED_COUNT][HEATMAP_MAX_NEIGHBOURS];
+static uint8_t     neighbour_count[RGB_MATRIX_LED_COUNT];
+#endif
+static bool tables_ready = false;
+
+static matrix_row_t previous[MATRIX_ROWS];
+static uint16_t     decay_timer;
+
+// With CORE1_ENABLE the heat lives on core 1, so everything that touches it
+// has to be in RAM and stay away from QMK and libc, see core1.h
+#ifdef CORE1_ENABLE
+#    define HEAT_FUNC CORE1_RAMFUNC
+#else
+#    define HEAT_FUNC
+#endif
+
+static inline __attribute__((always_inline)) uint8_t _qadd8(uint8_t a, uint8_t b) {
+    const uint16_t sum = a + b;
+    return sum > 255 ? 255 : sum;
+}
+
+// Four saturating byte subtracts in one go
+static inline __attribute__((always_inline)) uint32_t _qsub8x4(uint32_t a, uint32_t b) {
+    const uint32_t high   = 0x80808080;
+    const uint32_t diff   = ((a | high) - (b & ~high)) ^ ((a ^ ~b) & high);
+    const uint32_t borrow = ((~a & b) | (~(a ^ b) & diff)) & high;
+
+    return diff & ~((borrow >> 7) * 0xFF);
+}
+
+#ifndef LAYER_TABLE_HEAT_LEDS
+static void _add_neighbour(uint8_t led, uint8_t other, uint8_t weight) {
+    neighbour_t *list  = neighbours[led];
+    uint8_t      count = neighbour_count[led];
+
+    if (count == HEATMAP_MAX_NEIGHBOURS) {
+        if (weight <= list[count - 1].weight) {
+            return;
+        }
+        count--;
+    }
+
+    uint8_t i = count;
+    for (; i > 0 && list[i - 1].weight < weight; i--) {
+        list[i] = list[i - 1];
+    }
+    list[i]              = (neighbour_t){.led = other, .weight = weight};
+    neighbour_count[led] = count + 1;
+}
+
+static void _build_tables(void) {
+    bool is_key[RGB_MATRIX_LED_COUNT] = {false};
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            const uint8_t led = g_led_config.matrix_co[row][col];
+            if (led != NO_LED) {
+                is_key[led] = true;
+            }
+        }
+    }
+
+    for (uint8_t led = 0; led < RGB_MATRIX_LED_COUNT; led++) {
+        neighbour_count[led] = 0;
+        if (!is_key[led]) {
+            continue;
+        }
+
+        for (uint8_t other = 0; other < RGB_MATRIX_LED_COUNT; other++) {
+            if (other == led || !is_key[other]) {
+                continue;
+            }
+
+            const int16_t dx       = g_led_config.point[led].x - g_led_config.point[other].x;
+            const int16_t dy       = g_led_config.point[led].y - g_led_config.point[other].y;
+            const uint8_t distance = sqrt16(dx * dx + dy * dy);
+            if (distance <= HEATMAP_SPREAD) {
+                _add_neighbour(led, other, MIN(HEATMAP_SPREAD - distance, HEATMAP_AREA_LIMIT));
+            }
+        }
+    }
+
+    tables_ready = true;
+}
+#elif defined(CORE1_ENABLE)
+static void _build_tables(void) {
+    memcpy(neighbours, layer_table_heat, sizeof(neighbours));
+    memcpy(neighbour_count, layer_table_heat_count, sizeof(neighbour_count));
+    tables_ready = true;
+}
+#else
+static void _build_tables(void) {
+    tables_ready = true;
+}
+#endif // LAYER_TABLE_HEAT_LEDS
+
+static HEAT_FUNC void _heat(uint8_t led) {
+    heat.leds[led] = _qadd8(heat.leds[led], HEATMAP_PRESS_HEAT);
+
+    for (uint8_t i = 0; i < neighbour_count[led]; i++) {
+        const neighbour_t n = neighbours[led][i];
+        heat.leds[n.led]    = _qadd8(heat.leds[n.led], n.weight);
+    }
+}
+
+static HEAT_FUNC void _cool(uint8_t steps) {
+    const uint32_t amount = steps * 0x01010101;
+    for (uint8_t i = 0; i < HEAT_WORDS; i++) {
+        heat.words[i] = _qsub8x4(heat.words[i], amount);
+    }
+}
+
+static HEAT_FUNC void _clear(void) {
+    for (uint8_t i = 0; i < HEAT_WORDS; i++) {
+        heat.words[i] = 0;
+    }
+}
+
+// Steps of HEATMAP_DECAY_MS since the last call, at most 255
+static uint8_t _decay_steps(void) {
+    const uint16_t elapsed = timer_elapsed(decay_timer);
+    if (elapsed < HEATMAP_DECAY_MS) {
+        return 0;
+    }
+
+    const uint16_t steps = elapsed / HEATMAP_DECAY_MS;
+    decay_timer += steps * HEATMAP_DECAY_MS;
+    return MIN(steps, 255);
+}
+
+#ifdef CORE1_ENABLE
+
+// Core 0 tells core 1 about presses and settings through `events` and gets
+// finished frames back through `full`.  There are two frames: core 0 keeps
+// showing one until core 1 has finished the other, then swaps and returns
+// the old one through `empty`.
+
+#    include "spsc.h"
+
+typedef struct {
+    RGB leds[RGB_MATRIX_LED_COUNT];
+} heatmap_frame_t;
+
+typedef heatmap_frame_t *frame_ptr_t;
+
+enum heatmap_events {
+    EVENT_PRESS, // LED in the low byte
+    EVENT_COOL,  // steps in the low byte
+    EVENT_LOOK,  // saturation and value in the low bytes
+    EVENT_CLEAR,
+};
+
+#    define EVENT(type, arg) ((uint32_t)(type) << 24 | (arg))
+
+SPSC_QUEUE(event_queue, uint32_t, 32)
+SPSC_QUEUE(frame_queue, frame_ptr_t, 2)
+
+static event_queue_t   events;
+static frame_queue_t   full;
+static frame_queue_t   empty;
+static heatmap_frame_t frames[2];
+
+// Core 0 side
+static heatmap_frame_t *shown = NULL;
+static uint16_t         sent_look;
+
+static void _send(uint32_t event) {
+    // Dropping a press when core 1 is this far behind beats stalling the scan
+    event_queue_push(&events, &event);
+    core1_notify();
+}
+
+// hsv_to_rgb() from QMK's color.c without its division and switch, so it
+// can run from RAM
+static inline __attribute__((always_inline)) RGB _hsv_to_rgb(uint8_t h, uint8_t s, uint8_t v) {
+    if (s == 0) {
+        return (RGB){.r = v, .g = v, .b = v};
+    }
+
+    const uint16_t h6        = h * 6;
+    const uint8_t  region    = (h6 + 1 + (h6 >> 8)) >> 8; // h6 / 255
+    const uint8_t  remainder = (h * 2 - region * 85) * 3;
+
+    const uint8_t p = (v * (255 - s)) >> 8;
+    const uint8_t q = (v * (255 - ((s * remainder) >> 8))) >> 8;
+    const uint8_t t = (v * (255 - ((s * (255 - remainder)) >> 8))) >> 8;
+
+    if (region == 0 || region == 6) {
+        return (RGB){.r = v, .g = t, .b = p};
+    } else if (region == 1) {
+        return (RGB){.r = q, .g = v, .b = p};
+    } else if (region == 2) {
+        return (RGB){.r = p, .g = v, .b = t};
+    } else if (region == 3) {
+        return (RGB){.r = p, .g = q, .b = v};
+    } else if (region == 4) {
+        return (RGB){.r = t, .g = p, .b = v};
+    }
+    return (RGB){.r = v, .g = p, .b = q};
+}
+
+static HEAT_FUNC void _render(heatmap_frame_t *frame, uint8_t sat, uint8_t val) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        const uint8_t h      = heat.leds[i];
+        const uint8_t hue    = 170 - (h > 85 ? h - 85 : 0);
+        const uint8_t bright = ((_qadd8(170, h) - 170) * 3 * (val + 1)) >> 8;
+        frame->leds[i]       = _hsv_to_rgb(hue, sat, bright);
+    }
+}
+
+static HEAT_FUNC void _core1_main(void) {
+    uint8_t sat = 255;
+    uint8_t val = 255;
+
+    for (;;) {
+        uint32_t event;
+        while (event_queue_pop(&events, &event)) {
+            // No switch, its jump table would be in flash
+            const uint8_t type = event >> 24;
+            const uint8_t arg  = event & 0xFF;
+            if (type == EVENT_PRESS) {
+                _heat(arg);
+            } else if (type == EVENT_COOL) {
+                _cool(arg);
+            } else if (type == EVENT_LOOK) {
+                sat = (event >> 8) & 0xFF;
+                val = arg;
+            } else if (type == EVENT_CLEAR) {
+                _clear();
+            }
+        }
+
+        heatmap_frame_t *frame;
+        if (!frame_queue_pop(&empty, &frame)) {
+            core1_wait();
+            continue;
+        }
+        _render(frame, sat, val);
+        frame_queue_push(&full, &frame);
+    }
+}
+
+void heatmap_init(void) {
+    if (core1_running()) {
+        return;
+    }
+    _build_tables();
+
+    for (uint8_t i = 0; i < ARRAY_SIZE(frames); i++) {
+        heatmap_frame_t *frame = &frames[i];
+        memset(frame, 0, sizeof(*frame));
+        frame_queue_push(&empty, &frame);
+    }
+    core1_launch(_core1_main);
+}
+
+static void _pressed(uint8_t led) {
+    _send(EVENT(EVENT_PRESS, led));
+}
+
+bool heatmap_render(effect_params_t *params) {
+    RGB_MATRIX_USE_LIMITS(led_min, led_max);
+
+    if (!core1_running()) {
+        heatmap_init();
+    }
+
+    if (params->init) {
+        _send(EVENT(EVENT_CLEAR, 0));
+        decay_timer = timer_read();
+        sent_look   = 0;
+    }
+
+    if (params->iter == 0) {
+        const uint8_t steps = _decay_steps();
+        if (steps) {
+            _send(EVENT(EVENT_COOL, steps));
+        }
+
+        const uint16_t look = rgb_matrix_get_sat() << 8 | rgb_matrix_get_val();
+        if (look != sent_look || params->init) {
+            _send(EVENT(EVENT_LOOK, look));
+            sent_look = look;
+        }
+
+        // Swap to the newest finished frame, hand the old one back
+        heatmap_frame_t *frame;
+        while (frame_queue_pop(&full, &frame)) {
+            if (shown) {
+                frame_queue_push(&empty, &shown);
+            }
+            shown = frame;
+        }
+        core1_notify();
+    }
+
+    for (uint8_t i = led_min; i < led_max; i++) {
+        RGB_MATRIX_TEST_LED_FLAGS();
+
+        const RGB rgb = shown ? shown->leds[i] : (RGB){.r = 0, .g = 0, .b = 0};
+        rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
+    }
+    return rgb_matrix_check_finished_leds(led_max);
+}
+
+#else
+
+void heatmap_init(void) {
+    _build_tables();
+}
+
+static void _pressed(uint8_t led) {
+    _heat(led);
+}
+
+bool heatmap_render(effect_params_t *params) {
+    RGB_MATRIX_USE_LIMITS(led_min, led_max);
+
+    if (params->init) {
+        if (!tables_ready) {
+            heatmap_init();
+        }
+        _clear();
+        decay_timer = timer_read();
+    }
+
+    if (params->iter == 0) {
+        const uint8_t steps = _decay_steps();
+        if (steps) {
+            _cool(steps);
+        }
+    }
+
+    const uint8_t sat = rgb_matrix_get_sat();
+    const uint8_t val = rgb_matrix_get_val();
+    for (uint8_t i = led_min; i < led_max; i++) {
+        RGB_MATRIX_TEST_LED_FLAGS();
+
+        const uint8_t h   = heat.leds[i];
+        const HSV     hsv = {170 - qsub8(h, 85), sat, scale8((qadd8(170, h) - 170) * 3, val)};
+        const RGB     rgb = rgb_matrix_hsv_to_rgb(hsv);
+        rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
+    }
+    return rgb_matrix_check_finished_leds(led_max);
+}
+
+#endif // CORE1_ENABLE
+
+void heatmap_scan(void) {
+    const bool active = tables_ready && rgb_matrix_is_enabled() && rgb_matrix_get_mode() == RGB_MATRIX_CUSTOM_filbar_heatmap;
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        const matrix_row_t current = matrix_get_row(row);
+        matrix_row_t       pressed = current & ~previous[row];
+        previous[row]              = current;
+
+        if (!active) {
+            continue;
+        }
+
+        for (uint8_t col = 0; pressed; col++, pressed >>= 1) {
+            const uint8_t led = g_led_config.matrix_co[row][col];
+            if ((pressed & 1) && led != NO_LED) {
+                _pressed(led);
+            }
+        }
+    }
+}
+
+#endif // RGB_MATRIX_ENABLE
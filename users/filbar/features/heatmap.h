@@ -0,0 +1,54 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Typing heatmap effect (filbar_heatmap in rgb_matrix_user.inc).
+//
+// Same look as the stock TYPING_HEATMAP, but the stock effect measures the
+// distance from the pressed key to every LED, square roots and all, on every
+// press.  Here each key LED gets a list of its closest HEATMAP_MAX_NEIGHBOURS
+// key LEDs and how much heat they pick up.  tools/gen_layers.py works the
+// lists out into layer_tables.c for boards whose keyboard.json is in the
+// tree; on other boards heatmap_init() (queued as a deferred init stage)
+// works them out once from g_led_config.  A press then touches only those
+// few entries.
+//
+// Heat cools by one every HEATMAP_DECAY_MS, applied once per frame to four
+// LEDs at a time with a packed saturating subtract.
+//
+// Presses are picked up by diffing the matrix from matrix_scan_user() (call
+// heatmap_scan()), which works on both halves.
+//
+// With CORE1_ENABLE the heat, the cooling and the colour of every LED are
+// worked out on the RP2040's second core instead.  Core 0 only queues presses
+// and settings and copies finished frames to the LEDs, so the effect costs
+// the scan loop about the same however busy the animation is.
+
+#ifndef HEATMAP_SPREAD
+#    define HEATMAP_SPREAD 40 // LED distance heat still reaches
+#endif
+#ifndef HEATMAP_AREA_LIMIT
+#    define HEATMAP_AREA_LIMIT 16 // most a neighbour gets per press
+#endif
+#ifndef HEATMAP_PRESS_HEAT
+#    define HEATMAP_PRESS_HEAT 32 // what the pressed key itself gets
+#endif
+#ifndef HEATMAP_MAX_NEIGHBOURS
+#    define HEATMAP_MAX_NEIGHBOURS 8
+#endif
+#ifndef HEATMAP_DECAY_MS
+#    define HEATMAP_DECAY_MS 25
+#endif
+
+#ifdef RGB_MATRIX_ENABLE
+
+void heatmap_init(void);
+void heatmap_scan(void);
+bool heatmap_render(effect_params_t *params);
+
+#else
+
+static inline void heatmap_init(void) {}
+static inline void heatmap_scan(void) {}
+
+#endif // RGB_MATRIX_ENABLE
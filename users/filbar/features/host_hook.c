@@ -0,0 +1,39 @@
+#include "host_hook.h"
+#include "host.h"
+
+static host_driver_t proxy_driver;
+static host_driver_t *real_driver = NULL;
+
+static void proxy_send_keyboard(report_keyboard_t *report) {
+    host_hook_keyboard_report_user(report);
+    real_driver->send_keyboard(report);
+}
+
+#ifdef NKRO_ENABLE
+static void proxy_send_nkro(report_nkro_t *report) {
+    host_hook_nkro_report_user(report);
+    real_driver->send_nkro(report);
+}
+#endif // NKRO_ENABLE
+
+void host_hook_task(void) {
+    host_driver_t *driver = host_get_driver();
+    if (driver == NULL || driver == &proxy_driver) {
+        return;
+    }
+
+    // Keep everything else the driver does, only intercept the reports
+    real_driver                = driver;
+    proxy_driver               = *driver;
+    proxy_driver.send_keyboard = proxy_send_keyboard;
+#ifdef NKRO_ENABLE
+    proxy_driver.send_nkro = proxy_send_nkro;
+#endif // NKRO_ENABLE
+    host_set_driver(&proxy_driver);
+}
+
+__attribute__((weak)) void host_hook_keyboard_report_user(report_keyboard_t *report) {}
+
+#ifdef NKRO_ENABLE
+__attribute__((weak)) void host_hook_nkro_report_user(report_nkro_t *report) {}
+#endif // NKRO_ENABLE
@@ -0,0 +1,32 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Observe every HID keyboard report on its way to the host.
+//
+// QMK has no user hook for outgoing reports, so this copies the active host
+// driver and swaps in a proxy that calls host_hook_*_report_user() before
+// handing the report to the real driver.  The USB driver is only installed
+// after keyboard_post_init_user(), so call host_hook_task() from
+// housekeeping_task_user() and the proxy installs itself as soon as there is
+// a driver to wrap (never on the slave half).
+//
+// Built when a feature sets `HOST_HOOK_ENABLE = yes` in rules.mk.
+
+#ifdef HOST_HOOK_ENABLE
+
+void host_hook_task(void);
+
+// Called with each keyboard report just before it is sent.
+void host_hook_keyboard_report_user(report_keyboard_t *report);
+
+#    ifdef NKRO_ENABLE
+// Called with each NKRO report just before it is sent.
+void host_hook_nkro_report_user(report_nkro_t *report);
+#    endif // NKRO_ENABLE
+
+#else
+
+static inline void host_hook_task(void) {}
+
+#endif // HOST_HOOK_ENABLE
@@ -0,0 +1,142 @@
+#include "idle.h"
+
+#ifdef CONSOLE_ENABLE
+#   include "print.h"
+#endif // CONSOLE_ENABLE
+
+static const uint32_t tier_timeouts[IDLE_TIER_COUNT] = {
+    [IDLE_ACTIVE] = 0,
+    [IDLE_DIM]    = IDLE_DIM_TIMEOUT,
+    [IDLE_FREEZE] = IDLE_FREEZE_TIMEOUT,
+    [IDLE_OFF]    = IDLE_OFF_TIMEOUT,
+    [IDLE_DEEP]   = IDLE_DEEP_TIMEOUT,
+};
+
+#ifdef CONSOLE_ENABLE
+static const char *const tier_names[IDLE_TIER_COUNT] = {
+    [IDLE_ACTIVE] = "active",
+    [IDLE_DIM]    = "dim",
+    [IDLE_FREEZE] = "freeze",
+    [IDLE_OFF]    = "off",
+    [IDLE_DEEP]   = "deep",
+};
+#endif // CONSOLE_ENABLE
+
+static uint8_t  current_tier = IDLE_ACTIVE;
+static bool     follow_only  = false;
+static uint32_t tier_entered_at;
+static uint32_t time_in_tier[IDLE_TIER_COUNT];
+static uint32_t last_housekeeping;
+
+// What the RGB looked like before we touched it
+#ifdef RGB_MATRIX_ENABLE
+static uint8_t saved_val;
+static uint8_t saved_speed;
+static bool    saved_enabled;
+#endif // RGB_MATRIX_ENABLE
+
+static void enter_tier(uint8_t tier) {
+#ifdef RGB_MATRIX_ENABLE
+    if (is_keyboard_master()) {
+        if (current_tier < IDLE_DIM && tier >= IDLE_DIM) {
+            saved_val = rgb_matrix_get_val();
+            rgb_matrix_sethsv_noeeprom(rgb_matrix_get_hue(), rgb_matrix_get_sat(), saved_val / IDLE_DIM_DIVISOR);
+        }
+        if (current_tier < IDLE_FREEZE && tier >= IDLE_FREEZE) {
+            saved_speed = rgb_matrix_get_speed();
+            rgb_matrix_set_speed_noeeprom(0);
+        }
+        if (current_tier < IDLE_OFF && tier >= IDLE_OFF) {
+            saved_enabled = rgb_matrix_is_enabled();
+            rgb_matrix_disable_noeeprom();
+        }
+
+        // And back up, in reverse
+        if (current_tier >= IDLE_OFF && tier < IDLE_OFF && saved_enabled) {
+            rgb_matrix_enable_noeeprom();
+        }
+        if (current_tier >= IDLE_FREEZE && tier < IDLE_FREEZE) {
+            rgb_matrix_set_speed_noeeprom(saved_speed);
+        }
+        if (current_tier >= IDLE_DIM && tier < IDLE_DIM) {
+            rgb_matrix_sethsv_noeeprom(rgb_matrix_get_hue(), rgb_matrix_get_sat(), saved_val);
+        }
+    }
+#endif // RGB_MATRIX_ENABLE
+
+#ifdef OLED_ENABLE
+    if (current_tier < IDLE_OFF && tier >= IDLE_OFF) {
+        oled_off();
+    } else if (current_tier >= IDLE_OFF && tier < IDLE_OFF) {
+        oled_on();
+    }
+#endif // OLED_ENABLE
+
+    const uint32_t now = timer_read32();
+    time_in_tier[current_tier] += TIMER_DIFF_32(now, tier_entered_at);
+    tier_entered_at = now;
+    current_tier    = tier;
+}
+
+void idle_task(void) {
+    if (follow_only) {
+        return;
+    }
+
+    const uint32_t idle_for = last_input_activity_elapsed();
+
+    uint8_t tier = IDLE_ACTIVE;
+    while (tier + 1 < IDLE_TIER_COUNT && idle_for >= tier_timeouts[tier + 1]) {
+        tier++;
+    }
+    if (tier != current_tier) {
+        enter_tier(tier);
+    }
+}
+
+void idle_wake(void) {
+    if (current_tier != IDLE_ACTIVE && !follow_only) {
+        enter_tier(IDLE_ACTIVE);
+    }
+}
+
+uint8_t idle_get_tier(void) {
+    return current_tier;
+}
+
+void idle_set_tier(uint8_t tier) {
+    follow_only = true;
+    if (tier < IDLE_TIER_COUNT && tier != current_tier) {
+        enter_tier(tier);
+    }
+}
+
+bool idle_housekeeping_due(void) {
+    if (current_tier < IDLE_DEEP) {
+        return true;
+    }
+    if (timer_elapsed32(last_housekeeping) < IDLE_DEEP_HOUSEKEEPING_INTERVAL) {
+        return false;
+    }
+    last_housekeeping = timer_read32();
+    return true;
+}
+
+uint32_t idle_time_in_tier(uint8_t tier) {
+    if (tier >= IDLE_TIER_COUNT) {
+        return 0;
+    }
+    uint32_t total = time_in_tier[tier];
+    if (tier == current_tier) {
+        total += timer_elapsed32(tier_entered_at);
+    }
+    return total;
+}
+
+void idle_print(void) {
+#ifdef CONSOLE_ENABLE
+    for (uint8_t tier = 0; tier < IDLE_TIER_COUNT; tier++) {
+        uprintf("IDLE: %-6s %10lums%s\n", tier_names[tier], (unsigned long)idle_time_in_tier(tier), tier == current_tier ? " *" : "");
+    }
+#endif // CONSOLE_ENABLE
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Tiered idle governor for RGB, OLED and housekeeping.
+//
+// With no input for the configured time the keyboard steps down through
+//
+//   IDLE_DIM     RGB brightness divided by IDLE_DIM_DIVISOR
+//   IDLE_FREEZE  RGB animation speed set to zero
+//   IDLE_OFF     RGB and OLED off
+//   IDLE_DEEP    as above, and idle_housekeeping_due() only lets optional
+//                housekeeping run every IDLE_DEEP_HOUSEKEEPING_INTERVAL ms
+//
+// Call idle_task() from housekeeping_task_user() and idle_wake() at the very
+// start of process_record_user().  Waking restores everything before the key
+// is processed, so the key that wakes the board is neither dropped nor
+// delayed.  Every change is made with the _noeeprom calls, nothing is saved.
+//
+// RGB changes are made on the master half only, the slave picks them up from
+// the RGB sync.  The OLED is handled on each half, with SPLIT_ACTIVITY_ENABLE
+// giving the slave the master's idea of the last input.
+
+enum idle_tiers {
+    IDLE_ACTIVE = 0,
+    IDLE_DIM,
+    IDLE_FREEZE,
+    IDLE_OFF,
+    IDLE_DEEP,
+    IDLE_TIER_COUNT
+};
+
+#ifndef IDLE_DIM_TIMEOUT
+#    define IDLE_DIM_TIMEOUT 30000
+#endif
+#ifndef IDLE_FREEZE_TIMEOUT
+#    define IDLE_FREEZE_TIMEOUT 60000
+#endif
+#ifndef IDLE_OFF_TIMEOUT
+#    define IDLE_OFF_TIMEOUT 300000
+#endif
+#ifndef IDLE_DEEP_TIMEOUT
+#    define IDLE_DEEP_TIMEOUT 600000
+#endif
+
+#ifndef IDLE_DIM_DIVISOR
+#    define IDLE_DIM_DIVISOR 4
+#endif
+#ifndef IDLE_DEEP_HOUSEKEEPING_INTERVAL
+#    define IDLE_DEEP_HOUSEKEEPING_INTERVAL 250
+#endif
+
+void idle_task(void);
+void idle_wake(void);
+
+uint8_t idle_get_tier(void);
+
+// Forces a tier, for a slave half that follows the master's tier.
+void idle_set_tier(uint8_t tier);
+
+// True when optional housekeeping work should run this loop.
+bool idle_housekeeping_due(void);
+
+// Total time spent in a tier since boot, in ms.
+uint32_t idle_time_in_tier(uint8_t tier);
+
+void idle_print(void);
@@ -0,0 +1,198 @@
+#include "key_latency.h"
+
+#ifdef CONSOLE_ENABLE
+#   include "print.h"
+#endif // CONSOLE_ENABLE
+
+// Presses waiting for their report.  Anything still pending after
+// KEY_LATENCY_TIMEOUT was swallowed somewhere and is dropped.
+#ifndef KEY_LATENCY_PENDING
+#    define KEY_LATENCY_PENDING 8
+#endif
+#ifndef KEY_LATENCY_TIMEOUT
+#    define KEY_LATENCY_TIMEOUT 2000
+#endif
+
+typedef struct {
+    uint16_t detected_at;
+    uint8_t  hid_keycode; // 0 when the slot is free
+    uint8_t  key_class;
+} pending_key_t;
+
+static const char *const class_names[KEY_LATENCY_CLASS_COUNT] = {
+    [KEY_LATENCY_PLAIN]      = "plain",
+    [KEY_LATENCY_MOD_TAP]    = "mod-tap",
+    [KEY_LATENCY_LAYER_TAP]  = "layer-tap",
+    [KEY_LATENCY_AUTO_SHIFT] = "auto-shift",
+};
+
+static pending_key_t       pending[KEY_LATENCY_PENDING];
+static key_latency_stats_t class_stats[KEY_LATENCY_CLASS_COUNT];
+
+// Works out which HID keycode a press will end up sending, and why.  Returns
+// false for anything that does not put a key in the report.
+static bool classify(uint16_t keycode, keyrecord_t *record, uint8_t *hid_keycode, uint8_t *key_class) {
+    if (IS_QK_MOD_TAP(keycode)) {
+        if (record->tap.count == 0) {
+            return false;
+        }
+        *hid_keycode = QK_MOD_TAP_GET_TAP_KEYCODE(keycode);
+        *key_class   = KEY_LATENCY_MOD_TAP;
+        return true;
+    }
+
+#ifndef NO_ACTION_TAPPING
+    if (IS_QK_LAYER_TAP(keycode)) {
+        if (record->tap.count == 0) {
+            return false;
+        }
+        *hid_keycode = QK_LAYER_TAP_GET_TAP_KEYCODE(keycode);
+        *key_class   = KEY_LATENCY_LAYER_TAP;
+        return true;
+    }
+#endif // NO_ACTION_TAPPING
+
+    if (IS_QK_MODS(keycode)) {
+        keycode = QK_MODS_GET_BASIC_KEYCODE(keycode);
+    }
+    if (!IS_QK_BASIC(keycode)) {
+        return false;
+    }
+
+    *hid_keycode = keycode;
+    *key_class   = KEY_LATENCY_PLAIN;
+#ifdef AUTO_SHIFT_ENABLE
+    if (get_auto_shifted_key(keycode, record)) {
+        *key_class = KEY_LATENCY_AUTO_SHIFT;
+    }
+#endif // AUTO_SHIFT_ENABLE
+    return true;
+}
+
+void key_latency_record(uint16_t keycode, keyrecord_t *record) {
+    uint8_t hid_keycode, key_class;
+    if (!record->event.pressed || !classify(keycode, record, &hid_keycode, &key_class)) {
+        return;
+    }
+
+    // Take a free slot, or the oldest one if they are all waiting
+    pending_key_t *slot = &pending[0];
+    for (uint8_t i = 0; i < KEY_LATENCY_PENDING; i++) {
+        if (pending[i].hid_keycode == 0) {
+            slot = &pending[i];
+            break;
+        }
+        if (TIMER_DIFF_16(slot->detected_at, pending[i].detected_at) < 0x8000) {
+            slot = &pending[i];
+        }
+    }
+
+    slot->detected_at = record->event.time;
+    slot->hid_keycode = hid_keycode;
+    slot->key_class   = key_class;
+}
+
+static uint8_t histogram_bucket(uint16_t elapsed) {
+    uint8_t bucket = 0;
+    while (elapsed) {
+        elapsed >>= 1;
+        bucket++;
+    }
+    return MIN(bucket, KEY_LATENCY_HISTOGRAM_BUCKETS - 1);
+}
+
+static void record_latency(uint8_t key_class, uint16_t elapsed) {
+    key_latency_stats_t *stats = &class_stats[key_class];
+
+    if (stats->count == 0 || elapsed < stats->min_ms) {
+        stats->min_ms = elapsed;
+    }
+    if (elapsed > stats->max_ms) {
+        stats->max_ms = elapsed;
+    }
+    stats->count++;
+    stats->total_ms += elapsed;
+    stats->histogram[histogram_bucket(elapsed)]++;
+}
+
+// Matches pending presses against a report, `has_key` answers whether the
+// report carries a given HID keycode.
+static void match_report(bool (*has_key)(const void *, uint8_t), const void *report) {
+    const uint16_t now = timer_read();
+
+    for (uint8_t i = 0; i < KEY_LATENCY_PENDING; i++) {
+        pending_key_t *key = &pending[i];
+        if (key->hid_keycode == 0) {
+            continue;
+        }
+
+        const uint16_t elapsed = TIMER_DIFF_16(now, key->detected_at);
+        if (has_key(report, key->hid_keycode)) {
+            record_latency(key->key_class, elapsed);
+            key->hid_keycode = 0;
+        } else if (elapsed > KEY_LATENCY_TIMEOUT) {
+            key->hid_keycode = 0;
+        }
+    }
+}
+
+static bool keyboard_report_has_key(const void *report, uint8_t hid_keycode) {
+    const report_keyboard_t *keyboard = report;
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (keyboard->keys[i] == hid_keycode) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void key_latency_keyboard_report(const report_keyboard_t *report) {
+    match_report(keyboard_report_has_key, report);
+}
+
+#ifdef NKRO_ENABLE
+static bool nkro_report_has_key(const void *report, uint8_t hid_keycode) {
+    const report_nkro_t *nkro = report;
+    return (hid_keycode >> 3) < NKRO_REPORT_BITS && (nkro->bits[hid_keycode >> 3] & (1 << (hid_keycode & 7)));
+}
+
+void key_latency_nkro_report(const report_nkro_t *report) {
+    match_report(nkro_report_has_key, report);
+}
+#endif // NKRO_ENABLE
+
+const key_latency_stats_t *key_latency_get(uint8_t key_class) {
+    return key_class < KEY_LATENCY_CLASS_COUNT ? &class_stats[key_class] : NULL;
+}
+
+void key_latency_reset(void) {
+    memset(class_stats, 0, sizeof(class_stats));
+    memset(pending, 0, sizeof(pending));
+}
+
+void key_latency_print(void) {
+#ifdef CONSOLE_ENABLE
+    uprintf("LAT: %-10s %7s %5s %5s %5s (ms)\n", "class", "count", "min", "avg", "max");
+    for (uint8_t key_class = 0; key_class < KEY_LATENCY_CLASS_COUNT; key_class++) {
+        const key_latency_stats_t *stats = &class_stats[key_class];
+        if (stats->count == 0) {
+            continue;
+        }
+
+        uprintf("LAT: %-10s %7lu %5u %5lu %5u\n",
+            class_names[key_class],
+            (unsigned long)stats->count,
+            stats->min_ms,
+            (unsigned long)(stats->total_ms / stats->count),
+            stats->max_ms);
+
+        uprintf("LAT: %-10s", "");
+        for (uint8_t bucket = 0; bucket < KEY_LATENCY_HISTOGRAM_BUCKETS; bucket++) {
+            if (stats->histogram[bucket]) {
+                uprintf(" <%lu:%lu", (unsigned long)1 << bucket, (unsigned long)stats->histogram[bucket]);
+            }
+        }
+        uprintf("\n");
+    }
+#endif // CONSOLE_ENABLE
+}
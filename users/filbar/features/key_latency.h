@@ -0,0 +1,66 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Key-to-report latency.
+//
+// key_latency_record() is called from process_record_user() for every event.
+// Presses are tagged with their event time (record->event.time) and the
+// keycode they will eventually put in a report.  key_latency_*_report() is
+// then called with each outgoing report (see features/host_hook.h), and the
+// first report carrying a tagged keycode closes the measurement.
+//
+// The event time is taken on the master once the change has been debounced
+// and, for keys on the other half, merged in by the split transport, so the
+// number covers the firmware's own processing: tap-hold decisions, auto-shift
+// and anything else that holds a key back before its report.  Debounce, the
+// scan itself and the split transport come before it and are not included.
+//
+// Latencies are kept per keycode class in a log2 histogram of milliseconds.
+// A key counts as auto-shift when get_auto_shifted_key() takes it at press
+// time, so with AUTO_SHIFT_ENABLE that is every letter, digit and symbol
+// typed without a one-shot modifier pending (see the keymaps).  Holds of
+// tap-hold keys only produce modifiers or layer changes and are not
+// measured.
+//
+// Enable with `KEY_LATENCY_ENABLE = yes` in rules.mk.
+
+enum key_latency_classes {
+    KEY_LATENCY_PLAIN = 0,
+    KEY_LATENCY_MOD_TAP,
+    KEY_LATENCY_LAYER_TAP,
+    KEY_LATENCY_AUTO_SHIFT,
+    KEY_LATENCY_CLASS_COUNT
+};
+
+#ifndef KEY_LATENCY_HISTOGRAM_BUCKETS
+#    define KEY_LATENCY_HISTOGRAM_BUCKETS 12
+#endif
+
+typedef struct {
+    uint32_t count;
+    uint32_t total_ms;
+    uint16_t min_ms;
+    uint16_t max_ms;
+    uint32_t histogram[KEY_LATENCY_HISTOGRAM_BUCKETS];
+} key_latency_stats_t;
+
+#ifdef KEY_LATENCY_ENABLE
+
+void key_latency_record(uint16_t keycode, keyrecord_t *record);
+void key_latency_keyboard_report(const report_keyboard_t *report);
+#    ifdef NKRO_ENABLE
+void key_latency_nkro_report(const report_nkro_t *report);
+#    endif // NKRO_ENABLE
+
+const key_latency_stats_t *key_latency_get(uint8_t key_class);
+void key_latency_reset(void);
+void key_latency_print(void);
+
+#else
+
+static inline void key_latency_record(uint16_t keycode, keyrecord_t *record) {}
+static inline void key_latency_reset(void) {}
+static inline void key_latency_print(void) {}
+
+#endif // KEY_LATENCY_ENABLE
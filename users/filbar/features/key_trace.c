@@ -0,0 +1,27 @@
+#include "key_trace.h"
+
+#ifdef CONSOLE_ENABLE
+#   include "print.h"
+#endif // CONSOLE_ENABLE
+
+static matrix_row_t previous[MATRIX_ROWS];
+
+void key_trace_scan(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        const matrix_row_t current = matrix_get_row(row);
+        const matrix_row_t changed = current ^ previous[row];
+        if (!changed) {
+            continue;
+        }
+        previous[row] = current;
+
+#ifdef CONSOLE_ENABLE
+        const uint32_t now = timer_read32();
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            if (changed & ((matrix_row_t)1 << col)) {
+                uprintf("TRACE: %lu %u %u %u\n", (unsigned long)now, row, col, (current >> col) & 1);
+            }
+        }
+#endif // CONSOLE_ENABLE
+    }
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Raw key event trace for tools/latency_model.py.
+//
+// Prints every change of the debounced matrix, before any tap-hold or auto
+// shift logic gets to it, as
+//
+//     TRACE: <ms> <row> <col> <1 pressed|0 released>
+//
+// Call key_trace_scan() from matrix_scan_user().  Only the master sees the
+// whole matrix, record from the half plugged into the host.
+//
+// Enable with `KEY_TRACE_ENABLE = yes` in rules.mk (needs CONSOLE_ENABLE).
+
+#ifdef KEY_TRACE_ENABLE
+
+void key_trace_scan(void);
+
+#else
+
+static inline void key_trace_scan(void) {}
+
+#endif // KEY_TRACE_ENABLE
@@ -0,0 +1,69 @@
+#include "keymap_cache.h"
+#include "layer_tables.h"
+
+static uint16_t keycodes[MATRIX_ROWS][MATRIX_COLS];
+static uint8_t  source_layers[MATRIX_ROWS][MATRIX_COLS];
+
+static layer_state_t cached_state = 0;
+
+static void resolve(uint8_t row, uint8_t col, layer_state_t state) {
+    // The highest active layer that binds the key, layer 0 if none do
+    const layer_state_t bound = layer_table_bound[row][col] & state;
+    const uint8_t       layer = bound ? get_highest_layer(bound) : 0;
+
+    source_layers[row][col] = layer;
+    keycodes[row][col]      = keymap_key_to_keycode(layer, (keypos_t){.row = row, .col = col});
+}
+
+void keymap_cache_init(void) {
+    cached_state = layer_state | default_layer_state;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            resolve(row, col, cached_state);
+        }
+    }
+}
+
+void keymap_cache_refresh(void) {
+    const layer_state_t state   = layer_state | default_layer_state;
+    const layer_state_t changed = state ^ cached_state;
+    if (changed == 0) {
+        return;
+    }
+    cached_state = state;
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            // Only keys some toggled layer has an opinion on can change
+            if (layer_table_bound[row][col] & changed) {
+                resolve(row, col, state);
+            }
+        }
+    }
+}
+
+uint16_t keymap_cache_keycode(uint8_t row, uint8_t col) {
+    return keycodes[row][col];
+}
+
+uint8_t keymap_cache_layer(uint8_t row, uint8_t col) {
+    return source_layers[row][col];
+}
+
+#ifdef RAW_ENABLE
+bool keymap_cache_raw_hid(uint8_t *data, uint8_t length) {
+    if (length < 2 + MATRIX_COLS * 3 || data[0] != KEYMAP_CACHE_RAW_HID_ROW || data[1] >= MATRIX_ROWS) {
+        return false;
+    }
+
+    keymap_cache_refresh();
+
+    const uint8_t row = data[1];
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        data[2 + col * 2]               = keycodes[row][col] >> 8;
+        data[2 + col * 2 + 1]           = keycodes[row][col] & 0xFF;
+        data[2 + MATRIX_COLS * 2 + col] = source_layers[row][col];
+    }
+    return true;
+}
+#endif // RAW_ENABLE
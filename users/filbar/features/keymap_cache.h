@@ -0,0 +1,41 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Effective keymap cache.
+//
+// Holds the keycode each matrix position resolves to for the current
+// `layer_state | default_layer_state`, with KC_TRNS followed down through the
+// active layers the same way QMK does (falling back to layer 0).  Consumers
+// such as the LED indicators then cost a table read per key.
+//
+// keymap_cache_refresh() compares the layer state with the one the cache was
+// built for and, if it moved, re-resolves only the positions bound on a layer
+// that turned on or off.  Which layers bind a key comes from the keymap's
+// generated layer_table_bound (see tools/gen_layers.py), so resolving a key
+// is a mask and a bit scan rather than a walk down the layers.  Call it
+// before reading; it is cheap when nothing changed.  It is polled rather than
+// hooked into layer_state_set_user() because on the slave half QMK's split
+// transport writes layer_state directly (SPLIT_LAYER_STATE_ENABLE, set in
+// both keymaps' config.h).
+//
+// With RAW_ENABLE, keymap_cache_raw_hid() answers KEYMAP_CACHE_RAW_HID_ROW
+// queries: [cmd, row] -> [cmd, row, keycode hi/lo per column..., layer per
+// column...].
+
+#ifndef KEYMAP_CACHE_RAW_HID_ROW
+#    define KEYMAP_CACHE_RAW_HID_ROW 0x40
+#endif
+
+void keymap_cache_init(void);
+void keymap_cache_refresh(void);
+
+uint16_t keymap_cache_keycode(uint8_t row, uint8_t col);
+
+// The layer the keycode at this position comes from.
+uint8_t keymap_cache_layer(uint8_t row, uint8_t col);
+
+#ifdef RAW_ENABLE
+// Handles a cache query in place, returns false for anything else.
+bool keymap_cache_raw_hid(uint8_t *data, uint8_t length);
+#endif // RAW_ENABLE
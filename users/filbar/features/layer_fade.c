@@ -0,0 +1,65 @@
+#include "layer_fade.h"
+
+#ifdef RGB_MATRIX_ENABLE
+
+typedef struct {
+    uint16_t current[3]; // 8.8 fixed point
+    int16_t  step[3];
+    uint8_t  target[3];
+} fade_t;
+
+static fade_t  fades[RGB_MATRIX_LED_COUNT];
+static uint8_t frames_left = 0;
+
+void layer_fade_reset(RGB from) {
+    for (uint8_t led = 0; led < RGB_MATRIX_LED_COUNT; led++) {
+        fades[led].current[0] = from.r << 8;
+        fades[led].current[1] = from.g << 8;
+        fades[led].current[2] = from.b << 8;
+    }
+}
+
+void layer_fade_to(uint8_t led, RGB target) {
+    fade_t *fade = &fades[led];
+
+    fade->target[0] = target.r;
+    fade->target[1] = target.g;
+    fade->target[2] = target.b;
+
+    for (uint8_t i = 0; i < 3; i++) {
+        fade->step[i] = ((int32_t)(fade->target[i] << 8) - fade->current[i]) / LAYER_FADE_FRAMES;
+    }
+}
+
+void layer_fade_restart(void) {
+    frames_left = LAYER_FADE_FRAMES;
+}
+
+bool layer_fade_running(void) {
+    return frames_left > 0;
+}
+
+RGB layer_fade_next(uint8_t led) {
+    fade_t *fade = &fades[led];
+
+    // Land exactly on the target, the steps are rounded towards zero
+    if (frames_left <= 1) {
+        for (uint8_t i = 0; i < 3; i++) {
+            fade->current[i] = fade->target[i] << 8;
+        }
+    } else {
+        for (uint8_t i = 0; i < 3; i++) {
+            fade->current[i] += fade->step[i];
+        }
+    }
+
+    return (RGB){.r = fade->current[0] >> 8, .g = fade->current[1] >> 8, .b = fade->current[2] >> 8};
+}
+
+void layer_fade_frame_done(void) {
+    if (frames_left > 0) {
+        frames_left--;
+    }
+}
+
+#endif // RGB_MATRIX_ENABLE
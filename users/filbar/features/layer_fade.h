@@ -0,0 +1,37 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Layer transition fades for the indicator LEDs.
+//
+// On a layer change call layer_fade_to() for every LED with the colour it
+// should end up at, then layer_fade_restart().  That works out a fixed point
+// (8.8) step per channel from wherever the LED is now, so a fade that gets
+// interrupted by another layer change carries on from the colour it had
+// reached.  While layer_fade_running(), layer_fade_next() moves an LED one
+// step and returns its colour; that is one add per channel per frame.  Call
+// layer_fade_frame_done() once per frame (from rgb_matrix_indicators_user())
+// to count the fade down.  Once it is over nothing is left to do, draw the
+// target colours directly.
+//
+// LEDs that were last drawn by an effect rather than by the fade engine can be
+// given a starting colour with layer_fade_reset().
+
+#ifndef LAYER_FADE_FRAMES
+#    define LAYER_FADE_FRAMES 8
+#endif
+
+#ifdef RGB_MATRIX_ENABLE
+
+void layer_fade_reset(RGB from);
+void layer_fade_to(uint8_t led, RGB target);
+void layer_fade_restart(void);
+bool layer_fade_running(void);
+RGB  layer_fade_next(uint8_t led);
+void layer_fade_frame_done(void);
+
+#else
+
+static inline void layer_fade_frame_done(void) {}
+
+#endif // RGB_MATRIX_ENABLE
@@ -0,0 +1,78 @@
+#include "leader_trie.h"
+
+// Cursor value outside a sequence
+#define LEADER_TRIE_IDLE 0xFFFF
+
+static uint16_t cursor = LEADER_TRIE_IDLE;
+static uint16_t last_key;
+
+static void finish(void) {
+    const uint16_t action = pgm_read_word(&leader_trie[cursor].action);
+    cursor                = LEADER_TRIE_IDLE;
+    if (action != KC_NO) {
+        tap_code16(action);
+    }
+}
+
+static bool is_leaf(const leader_trie_node_t *node) {
+    for (uint8_t word = 0; word < LEADER_TRIE_WORDS; word++) {
+        if (pgm_read_dword(&node->children[word])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool process_leader_trie(uint16_t keycode, keyrecord_t *record, uint16_t leader_keycode) {
+    if (keycode == leader_keycode) {
+        if (record->event.pressed) {
+            cursor   = 0;
+            last_key = timer_read();
+        }
+        return false;
+    }
+    if (cursor == LEADER_TRIE_IDLE || !record->event.pressed) {
+        return true;
+    }
+
+    // Held tap-hold keys keep working, tapped ones count as their tap keycode
+    if (IS_QK_MOD_TAP(keycode) || IS_QK_LAYER_TAP(keycode)) {
+        if (record->tap.count == 0) {
+            return true;
+        }
+        keycode = IS_QK_MOD_TAP(keycode) ? QK_MOD_TAP_GET_TAP_KEYCODE(keycode) : QK_LAYER_TAP_GET_TAP_KEYCODE(keycode);
+    }
+    if (IS_MODIFIER_KEYCODE(keycode)) {
+        return true;
+    }
+
+    if (keycode < LEADER_TRIE_FIRST || keycode > LEADER_TRIE_LAST) {
+        cursor = LEADER_TRIE_IDLE;
+        return false;
+    }
+
+    const leader_trie_node_t *node   = &leader_trie[cursor];
+    const uint8_t             symbol = keycode - LEADER_TRIE_FIRST;
+    const uint8_t             word   = symbol / 32;
+    const uint32_t            bit    = (uint32_t)1 << (symbol % 32);
+    const uint32_t            bits   = pgm_read_dword(&node->children[word]);
+    if (!(bits & bit)) {
+        cursor = LEADER_TRIE_IDLE;
+        return false;
+    }
+
+    cursor   = pgm_read_word(&node->offset[word]) + __builtin_popcount(bits & (bit - 1));
+    last_key = timer_read();
+
+    // Nothing can follow, no need to wait for the timeout
+    if (is_leaf(&leader_trie[cursor])) {
+        finish();
+    }
+    return false;
+}
+
+void leader_trie_task(void) {
+    if (cursor != LEADER_TRIE_IDLE && timer_elapsed(last_key) > LEADER_TRIE_TIMEOUT) {
+        finish();
+    }
+}
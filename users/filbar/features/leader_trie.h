@@ -0,0 +1,60 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Leader key sequences from a trie in flash.
+//
+// Tapping the leader key starts a sequence; the keys after it walk down a
+// trie that tools/gen_layers.py builds from the "leader" list in
+// layouts/filbar/layers.json (leader_trie in the keymap's keymap.c).  Each
+// node has a bitmap of the keys that extend it, KC_A to KC_SLSH, and the
+// index of its first child in each 32-bit word of that bitmap, so the next
+// node is a bit test and a popcount however many sequences there are.  The
+// only RAM used is the cursor into the trie and the time of the last key.
+//
+// A sequence with nothing after it taps its action straight away.  One that
+// is also the start of a longer one waits LEADER_TRIE_TIMEOUT ms from the
+// last key, then taps its action if no key extends it.  Any key that does
+// not extend the sequence cancels it and is dropped; held mod-taps and
+// layer-taps and plain modifiers pass through.
+//
+// Call process_leader_trie() early in process_record_user() and
+// leader_trie_task() from housekeeping_task_user().
+//
+// Enable with `LEADER_TRIE_ENABLE = yes` in rules.mk.
+
+#ifndef LEADER_TRIE_TIMEOUT
+#    define LEADER_TRIE_TIMEOUT 300
+#endif
+
+// Keys a sequence can be typed with
+#define LEADER_TRIE_FIRST KC_A
+#define LEADER_TRIE_LAST KC_SLSH
+#define LEADER_TRIE_WORDS ((LEADER_TRIE_LAST - LEADER_TRIE_FIRST) / 32 + 1)
+
+// One sequence prefix: bit n of children is set when key LEADER_TRIE_FIRST
+// + n extends it, and those children are leader_trie[offset[n / 32]] on in
+// key order.  action is tapped when the sequence ends here, KC_NO for none.
+typedef struct {
+    uint32_t children[LEADER_TRIE_WORDS];
+    uint16_t offset[LEADER_TRIE_WORDS];
+    uint16_t action;
+} leader_trie_node_t;
+
+#ifdef LEADER_TRIE_ENABLE
+
+// Root first, generated in keymap.c
+extern const leader_trie_node_t leader_trie[];
+
+bool process_leader_trie(uint16_t keycode, keyrecord_t *record, uint16_t leader_keycode);
+void leader_trie_task(void);
+
+#else
+
+static inline bool process_leader_trie(uint16_t keycode, keyrecord_t *record, uint16_t leader_keycode) {
+    return true;
+}
+
+static inline void leader_trie_task(void) {}
+
+#endif // LEADER_TRIE_ENABLE
@@ -0,0 +1,333 @@
+#include "macro_recorder.h"
+
+#define NO_SLOT 0xFF
+#define STORE_MAGIC 0x4D52
+
+typedef struct {
+    uint16_t magic;
+    uint16_t length[MACRO_RECORDER_SLOTS];
+    uint8_t  arena[MACRO_RECORDER_ARENA];
+} macro_store_t;
+
+_Static_assert(sizeof(macro_store_t) == MACRO_RECORDER_STORE_SIZE, "MACRO_RECORDER_STORE_SIZE is out of date");
+#ifdef MACRO_RECORDER_PERSIST
+_Static_assert(EECONFIG_USER_DATA_SIZE == MACRO_RECORDER_STORE_SIZE, "Set EECONFIG_USER_DATA_SIZE to MACRO_RECORDER_STORE_SIZE");
+#endif // MACRO_RECORDER_PERSIST
+
+static macro_store_t store;
+
+// Recording, into the free space from record_start on
+static bool     armed;
+static uint8_t  recording = NO_SLOT;
+static uint16_t record_start;
+static uint16_t record_end;
+static uint16_t last_change;
+static uint8_t  last_mods;
+static uint8_t  last_keys[KEYBOARD_REPORT_KEYS];
+
+// Playback, with the keys it holds down so they can be let go at the end
+static uint8_t  playing = NO_SLOT;
+static bool     burst;
+static uint16_t play_pos;
+static uint16_t play_end;
+static uint16_t last_sent;
+static uint32_t down[8];
+static uint8_t  down_keys;
+
+static uint16_t slot_start(uint8_t slot) {
+    uint16_t start = 0;
+    for (uint8_t i = 0; i < slot; i++) {
+        start += store.length[i];
+    }
+    return start;
+}
+
+static void reverse(uint8_t *bytes, uint16_t length) {
+    for (uint16_t i = 0, j = length; i + 1 < j; i++, j--) {
+        const uint8_t byte = bytes[i];
+        bytes[i]           = bytes[j - 1];
+        bytes[j - 1]       = byte;
+    }
+}
+
+static bool is_down(uint8_t keycode) {
+    return down[keycode / 32] & ((uint32_t)1 << (keycode % 32));
+}
+
+// Recording
+
+static void stop_recording(void);
+
+static bool put(uint8_t keycode, bool pressed) {
+    uint32_t   elapsed = timer_elapsed(last_change);
+    const bool capped  = elapsed > MACRO_RECORDER_MAX_DELAY;
+    if (capped) {
+        elapsed = MACRO_RECORDER_MAX_DELAY;
+    }
+    // Round the recorded delays, not the errors, into the next change.  A
+    // capped pause starts over from now: left behind, last_change would
+    // stretch the changes after it, and the 16-bit timer wraps after 65 s.
+    const uint32_t ticks = elapsed / MACRO_RECORDER_TICK;
+    if (capped) {
+        last_change = timer_read();
+    } else {
+        last_change += ticks * MACRO_RECORDER_TICK;
+    }
+
+    uint8_t  bytes[5];
+    uint8_t  count = 0;
+    uint32_t value = ticks << 1 | pressed;
+    do {
+        bytes[count] = value & 0x7F;
+        value >>= 7;
+        if (value) {
+            bytes[count] |= 0x80;
+        }
+        count++;
+    } while (value);
+
+    if (record_end + count + 1 > MACRO_RECORDER_ARENA) {
+        stop_recording();
+        return false;
+    }
+    memcpy(&store.arena[record_end], bytes, count);
+    record_end += count;
+    store.arena[record_end++] = keycode;
+    return true;
+}
+
+static bool has_key(const uint8_t *keys, uint8_t keycode) {
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (keys[i] == keycode) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void macro_recorder_keyboard_report(report_keyboard_t *report) {
+    if (recording == NO_SLOT) {
+        return;
+    }
+
+    // Releases before presses, and mods outside the keys they apply to
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (last_keys[i] && !has_key(report->keys, last_keys[i]) && !put(last_keys[i], false)) {
+            return;
+        }
+    }
+    for (uint8_t bit = 0; bit < 8; bit++) {
+        if ((last_mods & ~report->mods) & (1 << bit) && !put(KC_LEFT_CTRL + bit, false)) {
+            return;
+        }
+    }
+    for (uint8_t bit = 0; bit < 8; bit++) {
+        if ((report->mods & ~last_mods) & (1 << bit) && !put(KC_LEFT_CTRL + bit, true)) {
+            return;
+        }
+    }
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (report->keys[i] && !has_key(last_keys, report->keys[i]) && !put(report->keys[i], true)) {
+            return;
+        }
+    }
+
+    last_mods = report->mods;
+    memcpy(last_keys, report->keys, sizeof(last_keys));
+}
+
+static void stop_playback(void);
+
+static void start_recording(uint8_t slot) {
+    stop_playback();
+
+    // Drop what the slot held, the later slots move down over it
+    const uint16_t start  = slot_start(slot);
+    const uint16_t length = store.length[slot];
+    const uint16_t used   = slot_start(MACRO_RECORDER_SLOTS);
+    memmove(&store.arena[start], &store.arena[start + length], used - start - length);
+    store.length[slot] = 0;
+
+    recording    = slot;
+    record_start = used - length;
+    record_end   = record_start;
+    last_change  = timer_read();
+    last_mods    = 0;
+    memset(last_keys, 0, sizeof(last_keys));
+}
+
+static void stop_recording(void) {
+    const uint8_t slot = recording;
+    recording          = NO_SLOT;
+
+    // Rotate the new recording in front of the later slots
+    const uint16_t start  = slot_start(slot);
+    const uint16_t later  = record_start - start;
+    const uint16_t length = record_end - record_start;
+    reverse(&store.arena[start], later);
+    reverse(&store.arena[record_start], length);
+    reverse(&store.arena[start], later + length);
+    store.length[slot] = length;
+
+#ifdef MACRO_RECORDER_PERSIST
+    eeconfig_update_user_datablock(&store);
+#endif // MACRO_RECORDER_PERSIST
+}
+
+// Playback
+
+// Reads the change at pos, returns where the next one starts
+static uint16_t next_change(uint16_t pos, uint32_t *ticks, uint8_t *keycode, bool *pressed) {
+    uint32_t value = 0;
+    for (uint8_t shift = 0; pos < play_end; shift += 7) {
+        const uint8_t byte = store.arena[pos++];
+        value |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            break;
+        }
+    }
+    *ticks   = value >> 1;
+    *pressed = value & 1;
+    *keycode = pos < play_end ? store.arena[pos++] : KC_NO;
+    return pos;
+}
+
+static void apply(uint8_t keycode, bool pressed) {
+    if (keycode == KC_NO || is_down(keycode) == pressed) {
+        return;
+    }
+    down[keycode / 32] ^= (uint32_t)1 << (keycode % 32);
+
+    if (IS_MODIFIER_KEYCODE(keycode)) {
+        if (pressed) {
+            add_mods(MOD_BIT(keycode));
+        } else {
+            del_mods(MOD_BIT(keycode));
+        }
+    } else if (pressed) {
+        add_key(keycode);
+        down_keys++;
+    } else {
+        del_key(keycode);
+        down_keys--;
+    }
+}
+
+static void start_playback(uint8_t slot, bool real_time) {
+    if (!store.length[slot]) {
+        return;
+    }
+    playing   = slot;
+    burst     = !real_time;
+    play_pos  = slot_start(slot);
+    play_end  = play_pos + store.length[slot];
+    last_sent = timer_read();
+}
+
+static void stop_playback(void) {
+    if (playing == NO_SLOT) {
+        return;
+    }
+    playing = NO_SLOT;
+
+    // Let go of whatever the macro still holds
+    for (uint16_t keycode = 0; keycode < 256; keycode++) {
+        if (is_down(keycode)) {
+            apply(keycode, false);
+        }
+    }
+    send_keyboard_report();
+}
+
+// One report's worth of changes that the host sees in the same order as
+// recorded: no key twice, no modifier after a key, no more keys than fit
+static void play_burst(void) {
+    uint32_t touched[8]   = {0};
+    bool     keys_changed = false;
+
+    while (play_pos < play_end) {
+        uint32_t       ticks;
+        uint8_t        keycode;
+        bool           pressed;
+        const uint16_t next = next_change(play_pos, &ticks, &keycode, &pressed);
+
+        const bool     modifier = IS_MODIFIER_KEYCODE(keycode);
+        const uint32_t bit      = (uint32_t)1 << (keycode % 32);
+        if ((touched[keycode / 32] & bit) || (modifier && keys_changed) ||
+            (pressed && !modifier && down_keys >= KEYBOARD_REPORT_KEYS)) {
+            break;
+        }
+
+        apply(keycode, pressed);
+        touched[keycode / 32] |= bit;
+        keys_changed = keys_changed || !modifier;
+        play_pos     = next;
+    }
+}
+
+void macro_recorder_task(void) {
+    if (playing == NO_SLOT) {
+        return;
+    }
+
+    if (burst) {
+        if (timer_elapsed(last_sent) < MACRO_RECORDER_BURST_INTERVAL) {
+            return;
+        }
+        play_burst();
+    } else {
+        uint32_t       ticks;
+        uint8_t        keycode;
+        bool           pressed;
+        const uint16_t next = next_change(play_pos, &ticks, &keycode, &pressed);
+        if (timer_elapsed(last_sent) < ticks * MACRO_RECORDER_TICK) {
+            return;
+        }
+        apply(keycode, pressed);
+        play_pos = next;
+    }
+
+    send_keyboard_report();
+    last_sent = timer_read();
+    if (play_pos >= play_end) {
+        stop_playback();
+    }
+}
+
+void macro_recorder_init(void) {
+#ifdef MACRO_RECORDER_PERSIST
+    eeconfig_read_user_datablock(&store);
+#endif // MACRO_RECORDER_PERSIST
+
+    if (store.magic != STORE_MAGIC || slot_start(MACRO_RECORDER_SLOTS) > MACRO_RECORDER_ARENA) {
+        memset(&store, 0, sizeof(store));
+        store.magic = STORE_MAGIC;
+    }
+}
+
+bool process_macro_recorder(uint16_t keycode, keyrecord_t *record, uint16_t record_keycode, uint16_t first_slot_keycode) {
+    const bool is_slot = keycode >= first_slot_keycode && keycode < first_slot_keycode + MACRO_RECORDER_SLOTS;
+    if (keycode != record_keycode && !is_slot) {
+        return true;
+    }
+    if (!record->event.pressed) {
+        return false;
+    }
+
+    if (recording != NO_SLOT) {
+        stop_recording();
+    } else if (keycode == record_keycode) {
+        armed = !armed;
+    } else if (armed) {
+        armed = false;
+        start_recording(keycode - first_slot_keycode);
+    } else if (playing != NO_SLOT) {
+        stop_playback();
+    } else {
+        // Shift picks the speed, it is not part of the macro
+        const bool real_time = get_mods() & MOD_MASK_SHIFT;
+        del_mods(MOD_MASK_SHIFT);
+        start_playback(keycode - first_slot_keycode, real_time);
+    }
+    return false;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Dynamic macro recorder.
+//
+// Records what the keyboard sends rather than the keys pressed: every
+// keyboard report on its way to the host (through features/host_hook.h) is
+// compared with the one before, and each key or modifier that changed is
+// stored as
+//
+//     varint((ticks << 1) | pressed)  HID keycode
+//
+// where ticks is the time since the previous change in MACRO_RECORDER_TICK
+// ms steps, capped at MACRO_RECORDER_MAX_DELAY.  A change after a short pause
+// takes two bytes, a typed key four.
+//
+// The slots share one arena of MACRO_RECORDER_ARENA bytes, stored back to
+// back in slot order, so a short macro leaves the space to a long one.
+// Recording goes to the free space at the end and is rotated into its slot
+// when it stops, replacing what was there; it stops by itself once the
+// arena is full.  With MACRO_RECORDER_PERSIST the arena is written to the
+// EECONFIG user datablock each time a recording stops and read back at
+// boot; on the RP2040 that is QMK's wear-levelled flash.  Set
+// EECONFIG_USER_DATA_SIZE to MACRO_RECORDER_STORE_SIZE.
+//
+// Tap the record key then a slot key to record into that slot, and the slot
+// key again (or the record key) to stop.  Tapping a slot key plays it in
+// bursts: as many changes per report as the host can tell apart, one report
+// every MACRO_RECORDER_BURST_INTERVAL ms.  Shifted, it plays at the speed it
+// was recorded.  Tapping any slot key during playback stops it.
+//
+// Call process_macro_recorder() from process_record_user(),
+// macro_recorder_keyboard_report() from host_hook_keyboard_report_user(),
+// macro_recorder_init() from keyboard_post_init_user() and
+// macro_recorder_task() from housekeeping_task_user().  Only 6KRO reports
+// are recorded.
+//
+// Enable with `MACRO_RECORDER_ENABLE = yes` in rules.mk.
+
+#ifndef MACRO_RECORDER_SLOTS
+#    define MACRO_RECORDER_SLOTS 3
+#endif
+
+#ifndef MACRO_RECORDER_ARENA
+#    define MACRO_RECORDER_ARENA 512
+#endif
+
+#ifndef MACRO_RECORDER_TICK
+#    define MACRO_RECORDER_TICK 4
+#endif
+
+#ifndef MACRO_RECORDER_MAX_DELAY
+#    define MACRO_RECORDER_MAX_DELAY 2000
+#endif
+
+#ifndef MACRO_RECORDER_BURST_INTERVAL
+#    define MACRO_RECORDER_BURST_INTERVAL 1
+#endif
+
+// Bytes the arena and its slot lengths take in the EECONFIG user datablock
+#define MACRO_RECORDER_STORE_SIZE (2 + 2 * MACRO_RECORDER_SLOTS + MACRO_RECORDER_ARENA)
+
+#ifdef MACRO_RECORDER_ENABLE
+
+void macro_recorder_init(void);
+void macro_recorder_task(void);
+void macro_recorder_keyboard_report(report_keyboard_t *report);
+
+// The slot keys are first_slot_keycode and the MACRO_RECORDER_SLOTS - 1
+// keycodes after it.
+bool process_macro_recorder(uint16_t keycode, keyrecord_t *record, uint16_t record_keycode, uint16_t first_slot_keycode);
+
+#else
+
+static inline void macro_recorder_init(void) {}
+static inline void macro_recorder_task(void) {}
+
+static inline bool process_macro_recorder(uint16_t keycode, keyrecord_t *record, uint16_t record_keycode, uint16_t first_slot_keycode) {
+    return true;
+}
+
+#endif // MACRO_RECORDER_ENABLE
@@ -0,0 +1,121 @@
+#include "mem_stats.h"
+
+#ifdef CONSOLE_ENABLE
+#   include "print.h"
+#endif // CONSOLE_ENABLE
+
+#if defined(PROTOCOL_CHIBIOS)
+#    include <ch.h>
+
+// Same fill value ChibiOS' crt0 uses with CRT0_INIT_STACKS, so our own paint
+// and the startup fill read the same.
+#    define STACK_PAINT 0x55555555
+
+// Leave this much below the live stack pointer alone when painting, it covers
+// the frames of the painting code itself.
+#    ifndef MEM_STATS_PAINT_MARGIN
+#        define MEM_STATS_PAINT_MARGIN 128
+#    endif
+
+// Provided by the ChibiOS linker scripts
+extern uint32_t __main_stack_base__, __main_stack_end__;
+extern uint32_t __process_stack_base__, __process_stack_end__;
+extern uint32_t __data_base__, __data_end__;
+extern uint32_t __bss_base__, __bss_end__;
+extern uint8_t  __heap_base__, __heap_end__;
+
+typedef struct {
+    uint32_t *base; // lowest address, the stack grows down towards it
+    uint32_t *end;
+} stack_region_t;
+
+static const stack_region_t regions[] = {
+    {&__main_stack_base__, &__main_stack_end__},
+    {&__process_stack_base__, &__process_stack_end__},
+};
+
+static mem_stats_stack_t stacks[] = {
+    {"main", 0, 0},
+    {"process", 0, 0},
+};
+
+static uint32_t last_scan = 0;
+
+static void paint(const stack_region_t *region, uintptr_t live_sp) {
+    uint32_t *limit = (uint32_t *)(live_sp - MEM_STATS_PAINT_MARGIN);
+    for (uint32_t *word = region->base; word < region->end && word < limit; word++) {
+        *word = STACK_PAINT;
+    }
+}
+
+// Untouched words are still painted, the first one that is not marks the
+// deepest the stack has been.
+static uint32_t scan(const stack_region_t *region) {
+    const uint32_t *word = region->base;
+    while (word < region->end && *word == STACK_PAINT) {
+        word++;
+    }
+    return (uintptr_t)region->end - (uintptr_t)word;
+}
+
+void mem_stats_init(void) {
+    // Interrupts run on the main stack, keep them out while it is painted
+    chSysLock();
+    paint(&regions[0], __get_MSP());
+    chSysUnlock();
+    paint(&regions[1], (uintptr_t)__builtin_frame_address(0));
+
+    for (uint8_t i = 0; i < ARRAY_SIZE(stacks); i++) {
+        stacks[i].size = (uintptr_t)regions[i].end - (uintptr_t)regions[i].base;
+    }
+    last_scan = timer_read32();
+}
+
+void mem_stats_task(void) {
+    if (timer_elapsed32(last_scan) < MEM_STATS_INTERVAL) {
+        return;
+    }
+    last_scan = timer_read32();
+
+    for (uint8_t i = 0; i < ARRAY_SIZE(stacks); i++) {
+        stacks[i].used = MAX(stacks[i].used, scan(&regions[i]));
+    }
+}
+
+uint8_t mem_stats_stack_count(void) {
+    return ARRAY_SIZE(stacks);
+}
+
+const mem_stats_stack_t *mem_stats_stack(uint8_t index) {
+    return index < ARRAY_SIZE(stacks) ? &stacks[index] : NULL;
+}
+
+void mem_stats_print(void) {
+#    ifdef CONSOLE_ENABLE
+    for (uint8_t i = 0; i < ARRAY_SIZE(stacks); i++) {
+        uprintf("MEM: stack %s %lu/%lu\n", stacks[i].name, (unsigned long)stacks[i].used, (unsigned long)stacks[i].size);
+    }
+
+    const uint32_t heap_size = &__heap_end__ - &__heap_base__;
+    uprintf("MEM: data %lu\n", (unsigned long)((uintptr_t)&__data_end__ - (uintptr_t)&__data_base__));
+    uprintf("MEM: bss %lu\n", (unsigned long)((uintptr_t)&__bss_end__ - (uintptr_t)&__bss_base__));
+    uprintf("MEM: heap %lu/%lu\n", (unsigned long)(heap_size - chCoreGetStatusX()), (unsigned long)heap_size);
+#    endif // CONSOLE_ENABLE
+}
+
+#else
+
+void mem_stats_init(void) {}
+void mem_stats_task(void) {}
+
+uint8_t mem_stats_stack_count(void) {
+    return 0;
+}
+
+const mem_stats_stack_t *mem_stats_stack(uint8_t index) {
+    return NULL;
+}
+
+void mem_stats_print(void) {}
+
+#endif // PROTOCOL_CHIBIOS
@@ -0,0 +1,48 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Stack and RAM high-water marks.
+//
+// mem_stats_init() paints the unused part of the main (interrupt) and process
+// (main loop) stacks with a known pattern; call it as early as possible, from
+// keyboard_pre_init_user().  mem_stats_task() then rescans the stacks every
+// MEM_STATS_INTERVAL ms from housekeeping_task_user() and keeps the deepest
+// point either one has reached.
+//
+// mem_stats_print() writes the stack marks and the .data, .bss and heap usage
+// to the console as `MEM:` lines.  tools/mem_report.py reads those lines back,
+// combined with the linker map for a per-feature breakdown of static RAM, and
+// fails when the headroom drops below a threshold.
+//
+// Only ChibiOS targets know where their stacks are.  Elsewhere this builds but
+// reports nothing.  Enable with `MEM_STATS_ENABLE = yes` in rules.mk.
+
+#ifndef MEM_STATS_INTERVAL
+#    define MEM_STATS_INTERVAL 1000
+#endif
+
+typedef struct {
+    const char *name;
+    uint32_t    size;
+    uint32_t    used; // high-water mark in bytes
+} mem_stats_stack_t;
+
+#ifdef MEM_STATS_ENABLE
+
+void mem_stats_init(void);
+void mem_stats_task(void);
+
+// Number of tracked stacks and their current high-water marks.
+uint8_t                  mem_stats_stack_count(void);
+const mem_stats_stack_t *mem_stats_stack(uint8_t index);
+
+void mem_stats_print(void);
+
+#else
+
+static inline void mem_stats_init(void) {}
+static inline void mem_stats_task(void) {}
+static inline void mem_stats_print(void) {}
+
+#endif // MEM_STATS_ENABLE
@@ -0,0 +1,143 @@
+#include "oled_legend.h"
+#include "keymap_cache.h"
+
+#define HALF_ROWS (MATRIX_ROWS / 2)
+
+// Basic keycodes, KC_A to KC_UP
+static const char PROGMEM basic_legends[][3] = {
+    "a",  "b",  "c",  "d",  "e",  "f",  "g",  "h",  "i",  "j",  "k",  "l",  "m",  "n",  "o",  "p",
+    "q",  "r",  "s",  "t",  "u",  "v",  "w",  "x",  "y",  "z",  "1",  "2",  "3",  "4",  "5",  "6",
+    "7",  "8",  "9",  "0",  "En", "Es", "Bs", "Tb", "Sp", "-",  "=",  "[",  "]",  "\\", "#",  ";",
+    "'",  "`",  ",",  ".",  "/",  "Cl", "F1", "F2", "F3", "F4", "F5", "F6", "F7", "F8", "F9", "10",
+    "11", "12", "Ps", "Sl", "Pa", "In", "Hm", "Pu", "De", "Ed", "Pd", ">",  "<",  "v",  "^",
+};
+
+// Shifted KC_1 to KC_SLSH, blank where shift gives nothing new
+static const char PROGMEM shifted_legends[] = "!@#$%^&*()\0\0\0\0\0_+{}|~:\"~<>?";
+
+_Static_assert(sizeof(basic_legends) / sizeof(basic_legends[0]) == KC_UP - KC_A + 1, "basic_legends is out of date");
+_Static_assert(sizeof(shifted_legends) - 1 == KC_SLSH - KC_1 + 1, "shifted_legends is out of date");
+
+static layer_state_t shown_state;
+
+__attribute__((weak)) const char *oled_legend_user(uint16_t keycode) {
+    return NULL;
+}
+
+static char mod_letter(uint8_t mods) {
+    return (mods & MOD_LGUI) ? 'G' : (mods & MOD_LALT) ? 'A' : (mods & MOD_LCTL) ? 'C' : 'S';
+}
+
+static void basic_legend(uint8_t keycode, char *legend) {
+    if (keycode >= KC_A && keycode <= KC_UP) {
+        strcpy_P(legend, basic_legends[keycode - KC_A]);
+    } else if (IS_MODIFIER_KEYCODE(keycode)) {
+        legend[0] = "CSAG"[keycode & 0x03];
+        legend[1] = 0;
+    }
+}
+
+static void layer_legend(char prefix, uint8_t layer, char *legend) {
+    legend[0] = prefix;
+    legend[1] = layer < 10 ? '0' + layer : '+';
+    legend[2] = 0;
+}
+
+// Up to two characters, empty for a blank
+static void legend_of(uint16_t keycode, char *legend) {
+    legend[0] = 0;
+    if (IS_QK_BASIC(keycode)) {
+        basic_legend(keycode, legend);
+    } else if (IS_QK_MODS(keycode)) {
+        const uint8_t mods  = QK_MODS_GET_MODS(keycode);
+        const uint8_t basic = QK_MODS_GET_BASIC_KEYCODE(keycode);
+        if (mods & ~MOD_LSFT) {
+            // A shortcut, its strongest modifier then the key
+            char key[3] = {0};
+            basic_legend(basic, key);
+            legend[0] = mod_letter(mods);
+            legend[1] = key[0];
+            legend[2] = 0;
+        } else if (basic >= KC_1 && basic <= KC_SLSH && pgm_read_byte(&shifted_legends[basic - KC_1])) {
+            legend[0] = pgm_read_byte(&shifted_legends[basic - KC_1]);
+            legend[1] = 0;
+        } else {
+            basic_legend(basic, legend);
+            if (basic >= KC_A && basic <= KC_Z) {
+                legend[0] += 'A' - 'a';
+            }
+        }
+    } else if (IS_QK_MOD_TAP(keycode)) {
+        basic_legend(QK_MOD_TAP_GET_TAP_KEYCODE(keycode), legend);
+    } else if (IS_QK_LAYER_TAP(keycode)) {
+        basic_legend(QK_LAYER_TAP_GET_TAP_KEYCODE(keycode), legend);
+    } else if (IS_QK_MOMENTARY(keycode)) {
+        layer_legend('M', QK_MOMENTARY_GET_LAYER(keycode), legend);
+    } else if (IS_QK_DEF_LAYER(keycode)) {
+        layer_legend('D', QK_DEF_LAYER_GET_LAYER(keycode), legend);
+    } else if (IS_QK_TOGGLE_LAYER(keycode)) {
+        layer_legend('T', QK_TOGGLE_LAYER_GET_LAYER(keycode), legend);
+    } else if (keycode >= SAFE_RANGE) {
+        const char *name = oled_legend_user(keycode);
+        if (name) {
+            strncpy(legend, name, 2);
+            legend[2] = 0;
+        }
+    }
+}
+
+static void draw(void) {
+    // Six keys a line on a wide display, three on a tall one, with a space
+    // between legends
+    const uint8_t per_line = (oled_max_chars() + 1) / 2 >= MATRIX_COLS ? MATRIX_COLS : MATRIX_COLS / 2;
+    const uint8_t pitch   = MIN((oled_max_chars() + 1) / per_line, 3);
+    const uint8_t parts   = MATRIX_COLS / per_line;
+    // A blank line between rows if there is room for it
+    const bool    spaced  = HALF_ROWS * (parts + 1) - 1 <= oled_max_lines();
+    const uint8_t first   = is_keyboard_left() ? 0 : HALF_ROWS;
+
+    uint8_t line = 0;
+    for (uint8_t row = 0; row < HALF_ROWS; row++) {
+        for (uint8_t part = 0; part < parts && line < oled_max_lines(); part++, line++) {
+            oled_set_cursor(0, line);
+            for (uint8_t i = 0; i < per_line; i++) {
+                const uint8_t key = part * per_line + i;
+                const uint8_t col = is_keyboard_left() ? key : MATRIX_COLS - 1 - key;
+                char          legend[3];
+                legend_of(keymap_cache_keycode(first + row, col), legend);
+                // The legend, then spaces up to the next key
+                bool ended = false;
+                for (uint8_t c = 0; c < pitch; c++) {
+                    ended = ended || c == pitch - 1 || !legend[c];
+                    oled_write_char(ended ? ' ' : legend[c], false);
+                }
+            }
+        }
+        if (spaced) {
+            line++;
+        }
+    }
+}
+
+bool oled_legend_render(void) {
+    keymap_cache_refresh();
+
+    const layer_state_t state = layer_state | default_layer_state;
+    if (get_highest_layer(state) == get_highest_layer(default_layer_state)) {
+        if (shown_state) {
+            // Hand a blank display back to the keyboard
+            oled_clear();
+            shown_state = 0;
+        }
+        return false;
+    }
+
+    if (state != shown_state) {
+        if (!shown_state) {
+            oled_clear();
+        }
+        draw();
+        shown_state = state;
+    }
+    return true;
+}
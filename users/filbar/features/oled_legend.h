@@ -0,0 +1,29 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Legends of the active layer on the OLEDs.
+//
+// While a layer above the default one is on, each half draws what its own
+// keys do, read from the keymap cache (features/keymap_cache.h).  The slave
+// only shows the same layer as the master with SPLIT_LAYER_STATE_ENABLE in
+// the keymap's config.h, which has QMK's split transport copy the layer
+// state across.  Rows are drawn top to bottom and columns as they sit under
+// the hand: matrix column 0 is the outer one on both halves, as in the
+// Lily58's keyboard.json.  The grid follows the display's rotation, six keys
+// per line with two-character legends when it is wide, three with one
+// character when it is tall, and rows that do not fit are left out.
+//
+// Basic keys, shifted symbols, tap-hold keys (by their tap) and layer keys
+// get built-in legends.  Keymap keycodes from SAFE_RANGE on are blank unless
+// oled_legend_user() names them.
+//
+// Call oled_legend_render() from oled_task_user() and let the keyboard draw
+// only when it returns false; it also clears the display when the default
+// layer comes back.  Built when OLED_ENABLE = yes.
+
+// Draws the legends if a layer is on, returns whether it did.
+bool oled_legend_render(void);
+
+// Legend of up to two characters for a keymap keycode, NULL for a blank.
+const char *oled_legend_user(uint16_t keycode);
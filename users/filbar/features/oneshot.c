@@ -0,0 +1,46 @@
+#include "oneshot.h"
+
+void update_oneshot(oneshot_state *state, uint16_t mod, uint16_t trigger, uint16_t keycode, keyrecord_t *record) {
+    if (keycode == trigger) {
+        if (record->event.pressed) {
+            // Trigger keydown
+            if (*state == os_up_unqueued) {
+                register_code(mod);
+            }
+            *state = os_down_unused;
+        } else {
+            // Trigger keyup
+            switch (*state) {
+                case os_down_unused:
+                    // Nothing used it while it was held, queue it
+                    *state = os_up_queued;
+                    break;
+                case os_down_used:
+                    // Chorded, let it go like a plain modifier
+                    *state = os_up_unqueued;
+                    unregister_code(mod);
+                    break;
+                default:
+                    break;
+            }
+        }
+    } else if (record->event.pressed) {
+        if (is_oneshot_cancel_key(keycode, record) && *state != os_up_unqueued) {
+            *state = os_up_unqueued;
+            unregister_code(mod);
+        }
+    } else if (!is_oneshot_ignored_key(keycode, record)) {
+        // On a keyup that is not ignored, the modifier has been used
+        switch (*state) {
+            case os_down_unused:
+                *state = os_down_used;
+                break;
+            case os_up_queued:
+                *state = os_up_unqueued;
+                unregister_code(mod);
+                break;
+            default:
+                break;
+        }
+    }
+}
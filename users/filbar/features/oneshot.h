@@ -0,0 +1,42 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// One-shot modifiers without timers, the sibling of swapper.h.
+//
+// Each modifier key runs its own four-state machine:
+//
+//     trigger, a           -> mod down, a, mod up
+//     trigger held, a      -> mod down, a, mod up with the trigger
+//     trigger, trigger2, a -> both mods down, a, both up
+//
+// Pressing the trigger registers the modifier at once.  Released without
+// another key having been released meanwhile, it stays queued until the
+// next key is released; otherwise it is let go with the trigger like a
+// plain modifier.  Nothing depends on how long a key is held, so there is
+// no tapping term to wait out.
+//
+// The keymap picks the keys that cancel a queued modifier when pressed
+// (layer keys, usually) and the keys that do not use one up (other
+// triggers, layer keys, layer lock) by defining the two functions below.
+// Held layer-taps should be ignored and tapped ones not; record->tap.count
+// tells them apart.
+//
+// Call update_oneshot() from process_record_user() for each modifier, with
+// its own state, before anything that can swallow a key.
+
+// Represents the four states a oneshot key can be in
+typedef enum {
+    os_up_unqueued,
+    os_up_queued,
+    os_down_unused,
+    os_down_used,
+} oneshot_state;
+
+void update_oneshot(oneshot_state *state, uint16_t mod, uint16_t trigger, uint16_t keycode, keyrecord_t *record);
+
+// Keys that drop a queued or held modifier on press, defined by the keymap
+bool is_oneshot_cancel_key(uint16_t keycode, keyrecord_t *record);
+
+// Keys that do not count as using a modifier, defined by the keymap
+bool is_oneshot_ignored_key(uint16_t keycode, keyrecord_t *record);
@@ -0,0 +1,131 @@
+#include "position_combo.h"
+
+// Presses held back while they could still be a combo, oldest first
+static keyevent_t held[POSITION_COMBO_KEYS];
+static uint8_t    held_count;
+
+static position_combo_keys_t held_keys;
+static position_combo_mask_t candidates;
+
+// The combo that fired, until the first of its keys is released
+static position_combo_keys_t active_keys;
+static uint16_t              active_action;
+
+// Set while the held back presses go through QMK again
+static bool replaying;
+
+static position_combo_keys_t read_keys(uint8_t combo) {
+    const position_combo_keys_t *keys = &position_combos[combo].keys;
+    const uint32_t               low  = pgm_read_dword((const uint32_t *)keys);
+    const uint32_t               high = pgm_read_dword((const uint32_t *)keys + 1);
+    return (position_combo_keys_t)high << 32 | low;
+}
+
+// A candidate whose keys are exactly the ones held back, -1 for none
+static int8_t complete_combo(void) {
+    for (position_combo_mask_t mask = candidates; mask; mask &= mask - 1) {
+        const uint8_t combo = __builtin_ctz(mask);
+        if (read_keys(combo) == held_keys) {
+            return combo;
+        }
+    }
+    return -1;
+}
+
+static void reset(void) {
+    held_count = 0;
+    held_keys  = 0;
+    candidates = 0;
+}
+
+static void fire(uint8_t combo) {
+    active_keys   = read_keys(combo);
+    active_action = pgm_read_word(&position_combos[combo].action);
+    register_code16(active_action);
+    reset();
+}
+
+// Fires the complete candidate, or lets the held back presses through
+static void resolve(void) {
+    const int8_t combo = complete_combo();
+    if (combo >= 0) {
+        fire(combo);
+        return;
+    }
+
+    const uint8_t count = held_count;
+    reset();
+    replaying = true;
+    for (uint8_t i = 0; i < count; i++) {
+        action_exec(held[i]);
+    }
+    replaying = false;
+}
+
+static bool on_typing_layer(void) {
+    return LAYER_TABLE_TYPING & ((layer_table_t)1 << get_highest_layer(layer_state | default_layer_state));
+}
+
+bool pre_process_position_combo(uint16_t keycode, keyrecord_t *record) {
+    if (replaying) {
+        return true;
+    }
+
+    const keypos_t key  = record->event.key;
+    const uint8_t  slot = key.row < MATRIX_ROWS && key.col < MATRIX_COLS ? layer_table_slots[key.row][key.col] : 0;
+    if (slot == 0) {
+        if (held_count) {
+            resolve();
+        }
+        return true;
+    }
+    const position_combo_keys_t bit = (position_combo_keys_t)1 << (slot - 1);
+
+    if (!record->event.pressed) {
+        if (active_keys & bit) {
+            if (active_action != KC_NO) {
+                unregister_code16(active_action);
+                active_action = KC_NO;
+            }
+            active_keys &= ~bit;
+            return false;
+        }
+        if (held_count) {
+            resolve();
+        }
+        return true;
+    }
+
+    const position_combo_mask_t combos = on_typing_layer() ? pgm_read_dword(&position_combo_index[slot - 1]) : 0;
+    if (held_count) {
+        const position_combo_mask_t narrowed = candidates & combos;
+        if (narrowed && held_count < POSITION_COMBO_KEYS) {
+            held[held_count++] = record->event;
+            held_keys |= bit;
+            candidates = narrowed;
+
+            // Done once nothing larger could still match
+            const int8_t combo = complete_combo();
+            if (combo >= 0 && candidates == (position_combo_mask_t)1 << combo) {
+                fire(combo);
+            }
+            return false;
+        }
+        resolve();
+    }
+
+    if (!combos) {
+        return true;
+    }
+    held[0]    = record->event;
+    held_count = 1;
+    held_keys  = bit;
+    candidates = combos;
+    return false;
+}
+
+void position_combo_task(void) {
+    if (held_count && timer_elapsed(held[0].time) > POSITION_COMBO_TERM) {
+        resolve();
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+#include "layer_tables.h"
+
+// Combos by key position.
+//
+// A combo is a set of layout positions rather than keycodes, so the same
+// physical chord works on Colemak and Qwerty.  tools/gen_layers.py builds
+// them from the "combos" list in layouts/filbar/layers.json (position_combos
+// and position_combo_index in the keymap's keymap.c).  Positions come from
+// layer_table_slots.
+//
+// A press of a key that is in some combo is held back, and the combos it is
+// in become the candidates.  Each further press narrows the candidates with
+// one read of position_combo_index, and only the candidates are compared
+// with the keys held back, so the cost of an event does not grow with the
+// number of combos.  A combo fires once its keys are all down and no larger
+// candidate is left.  A key outside the candidates, a release, or
+// POSITION_COMBO_TERM ms since the first key went down fires the complete
+// candidate if there is one, and otherwise replays the keys held back as
+// they were pressed.  The
+// action is registered until the first of the combo's keys is released.
+//
+// Combos only fire on the typing layers (LAYER_TABLE_TYPING).  Call
+// pre_process_position_combo() from pre_process_record_user(), so keys are
+// held back before tap-hold sees them, and position_combo_task() from
+// housekeeping_task_user().
+//
+// Enable with `POSITION_COMBO_ENABLE = yes` in rules.mk.
+
+#ifndef POSITION_COMBO_TERM
+#    define POSITION_COMBO_TERM 40
+#endif
+
+// Keys in a combo at most, the keys held back
+#define POSITION_COMBO_KEYS 4
+
+// A set of combos, bit n for position_combos[n]
+typedef uint32_t position_combo_mask_t;
+
+// A set of layout positions, bit n for the key in layer_table_slots n + 1
+typedef uint64_t position_combo_keys_t;
+
+typedef struct {
+    position_combo_keys_t keys;
+    uint16_t              action;
+} position_combo_t;
+
+#ifdef POSITION_COMBO_ENABLE
+
+// Generated in keymap.c
+extern const position_combo_t      position_combos[];
+extern const position_combo_mask_t position_combo_index[LAYER_TABLE_KEYS];
+
+bool pre_process_position_combo(uint16_t keycode, keyrecord_t *record);
+void position_combo_task(void);
+
+#else
+
+static inline bool pre_process_position_combo(uint16_t keycode, keyrecord_t *record) {
+    return true;
+}
+
+static inline void position_combo_task(void) {}
+
+#endif // POSITION_COMBO_ENABLE
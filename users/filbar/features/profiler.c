@@ -0,0 +1,89 @@
+#include "profiler.h"
+#include "timer_us.h"
+
+#ifdef CONSOLE_ENABLE
+#   include "print.h"
+#endif // CONSOLE_ENABLE
+
+static const char *const zone_names[PROF_ZONE_COUNT] = {
+    [PROF_PROCESS_RECORD]  = "process_record",
+    [PROF_LAYER_LOCK]      = "layer_lock",
+    [PROF_SWAPPER]         = "swapper",
+    [PROF_RGB_INDICATORS]  = "rgb_indicators",
+    [PROF_LAYER_LOCK_TASK] = "layer_lock_task",
+};
+
+static profiler_stats_t zone_stats[PROF_ZONE_COUNT];
+static uint32_t         zone_started_at[PROF_ZONE_COUNT];
+
+void profiler_enter(uint8_t zone) {
+    if (zone < PROF_ZONE_COUNT) {
+        zone_started_at[zone] = timer_read_us();
+    }
+}
+
+// log2 bucket for a duration: 0 for 0us, k for [2^(k-1), 2^k)
+static uint8_t histogram_bucket(uint32_t elapsed) {
+    uint8_t bucket = 0;
+    while (elapsed) {
+        elapsed >>= 1;
+        bucket++;
+    }
+    return MIN(bucket, PROFILER_HISTOGRAM_BUCKETS - 1);
+}
+
+void profiler_exit(uint8_t zone) {
+    if (zone >= PROF_ZONE_COUNT) {
+        return;
+    }
+
+    const uint32_t    elapsed = timer_elapsed_us(zone_started_at[zone]);
+    profiler_stats_t *stats   = &zone_stats[zone];
+
+    if (stats->count == 0 || elapsed < stats->min_us) {
+        stats->min_us = elapsed;
+    }
+    if (elapsed > stats->max_us) {
+        stats->max_us = elapsed;
+    }
+    stats->count++;
+    stats->total_us += elapsed;
+    stats->histogram[histogram_bucket(elapsed)]++;
+}
+
+const profiler_stats_t *profiler_get(uint8_t zone) {
+    return zone < PROF_ZONE_COUNT ? &zone_stats[zone] : NULL;
+}
+
+void profiler_reset(void) {
+    memset(zone_stats, 0, sizeof(zone_stats));
+}
+
+void profiler_print(void) {
+#ifdef CONSOLE_ENABLE
+    uprintf("PROF: %-16s %8s %10s %6s %6s %6s\n", "zone", "count", "total_us", "min", "avg", "max");
+    for (uint8_t zone = 0; zone < PROF_ZONE_COUNT; zone++) {
+        const profiler_stats_t *stats = &zone_stats[zone];
+        if (stats->count == 0) {
+            continue;
+        }
+
+        uprintf("PROF: %-16s %8lu %10lu %6lu %6lu %6lu\n",
+            zone_names[zone],
+            (unsigned long)stats->count,
+            (unsigned long)stats->total_us,
+            (unsigned long)stats->min_us,
+            (unsigned long)(stats->total_us / stats->count),
+            (unsigned long)stats->max_us);
+
+        // Histogram, one `<limit:count` pair per non-empty bucket
+        uprintf("PROF: %-16s", "");
+        for (uint8_t bucket = 0; bucket < PROFILER_HISTOGRAM_BUCKETS; bucket++) {
+            if (stats->histogram[bucket]) {
+                uprintf(" <%lu:%lu", (unsigned long)1 << bucket, (unsigned long)stats->histogram[bucket]);
+            }
+        }
+        uprintf("\n");
+    }
+#endif // CONSOLE_ENABLE
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Named-zone cycle profiler for the userspace hooks.
+//
+// Wrap the code to be measured in a zone:
+//
+//     PROFILE_ENTER(PROF_SWAPPER);
+//     update_swapper(...);
+//     PROFILE_EXIT(PROF_SWAPPER);
+//
+// Each zone accumulates a call count, total/min/max time in microseconds and a
+// log2 histogram (bucket k holds durations in [2^(k-1), 2^k) us, bucket 0 is
+// sub-microsecond).  Call profiler_print() to dump the table to the console.
+//
+// Enable with `PROFILER_ENABLE = yes` in rules.mk.  When disabled the macros
+// expand to nothing and profiler.c is not built, so zones can stay in place.
+// Zones may nest but a zone must not be re-entered before it exits.
+
+enum profiler_zones {
+    PROF_PROCESS_RECORD = 0,
+    PROF_LAYER_LOCK,
+    PROF_SWAPPER,
+    PROF_RGB_INDICATORS,
+    PROF_LAYER_LOCK_TASK,
+    PROF_ZONE_COUNT
+};
+
+#ifndef PROFILER_HISTOGRAM_BUCKETS
+#    define PROFILER_HISTOGRAM_BUCKETS 16
+#endif
+
+typedef struct {
+    uint32_t count;
+    uint32_t total_us;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint32_t histogram[PROFILER_HISTOGRAM_BUCKETS];
+} profiler_stats_t;
+
+#ifdef PROFILER_ENABLE
+
+#    define PROFILE_ENTER(zone) profiler_enter(zone)
+#    define PROFILE_EXIT(zone) profiler_exit(zone)
+
+void profiler_enter(uint8_t zone);
+void profiler_exit(uint8_t zone);
+
+// Returns the accumulated stats for a zone, or NULL for an unknown zone.
+const profiler_stats_t *profiler_get(uint8_t zone);
+
+// Clears every zone.
+void profiler_reset(void);
+
+// Dumps every zone that has been hit to the console (needs CONSOLE_ENABLE).
+void profiler_print(void);
+
+#else
+
+#    define PROFILE_ENTER(zone) ((void)0)
+#    define PROFILE_EXIT(zone) ((void)0)
+
+static inline void profiler_reset(void) {}
+static inline void profiler_print(void) {}
+
+#endif // PROFILER_ENABLE
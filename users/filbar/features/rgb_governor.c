@@ -0,0 +1,95 @@
+#include "rgb_governor.h"
+#include "timer_us.h"
+
+#ifdef CONSOLE_ENABLE
+#   include "print.h"
+#endif // CONSOLE_ENABLE
+
+#ifdef RGB_MATRIX_ENABLE
+
+// Read by rgb_matrix.c through RGB_MATRIX_LED_FLUSH_LIMIT
+uint32_t rgb_governor_flush_limit = RGB_GOVERNOR_BASE_INTERVAL;
+
+static uint8_t level = 0;
+
+// Times of the last few presses, to spot bursts
+static uint16_t presses[RGB_GOVERNOR_BURST_KEYS];
+static uint8_t  next_press = 0;
+static uint16_t calm_since;
+
+static uint32_t scan_started_at;
+static uint32_t frame_cost;
+static uint32_t last_frame_cost;
+static uint32_t max_frame_cost;
+static uint32_t over_budget_frames;
+
+static void set_level(uint8_t new_level) {
+    level                    = MIN(new_level, RGB_GOVERNOR_MAX_LEVEL);
+    rgb_governor_flush_limit = (uint32_t)RGB_GOVERNOR_BASE_INTERVAL << level;
+    calm_since               = timer_read();
+}
+
+void rgb_governor_keypress(void) {
+    const uint16_t now = timer_read();
+
+    // The oldest of the last N presses is recent enough, we are in a burst
+    const uint16_t oldest = presses[next_press];
+    presses[next_press]   = now;
+    next_press            = (next_press + 1) % RGB_GOVERNOR_BURST_KEYS;
+
+    if (oldest != 0 && TIMER_DIFF_16(now, oldest) < RGB_GOVERNOR_BURST_WINDOW) {
+        set_level(RGB_GOVERNOR_MAX_LEVEL);
+    }
+    calm_since = now;
+}
+
+void rgb_governor_scan_start(void) {
+    scan_started_at = timer_read_us();
+}
+
+void rgb_governor_chunk_done(void) {
+    frame_cost += timer_elapsed_us(scan_started_at);
+}
+
+void rgb_governor_frame_done(void) {
+    last_frame_cost = frame_cost;
+    max_frame_cost  = MAX(max_frame_cost, frame_cost);
+    frame_cost      = 0;
+
+    if (last_frame_cost > RGB_GOVERNOR_FRAME_BUDGET_US) {
+        over_budget_frames++;
+        set_level(level + 1);
+    } else if (level > 0 && timer_elapsed(calm_since) > RGB_GOVERNOR_RESTORE_MS) {
+        set_level(level - 1);
+    }
+}
+
+uint8_t rgb_governor_level(void) {
+    return level;
+}
+
+void rgb_governor_print(void) {
+#    ifdef CONSOLE_ENABLE
+    uprintf("RGB: frame every %lums (level %u), last frame %luus, max %luus, %lu over budget\n",
+        (unsigned long)rgb_governor_flush_limit,
+        level,
+        (unsigned long)last_frame_cost,
+        (unsigned long)max_frame_cost,
+        (unsigned long)over_budget_frames);
+#    endif // CONSOLE_ENABLE
+}
+
+#else
+
+void rgb_governor_keypress(void) {}
+void rgb_governor_scan_start(void) {}
+void rgb_governor_chunk_done(void) {}
+void rgb_governor_frame_done(void) {}
+
+uint8_t rgb_governor_level(void) {
+    return 0;
+}
+
+void rgb_governor_print(void) {}
+
+#endif // RGB_MATRIX_ENABLE
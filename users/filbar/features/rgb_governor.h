@@ -0,0 +1,51 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Adaptive RGB frame-rate governor.
+//
+// config.h points RGB_MATRIX_LED_FLUSH_LIMIT at rgb_governor_flush_limit, so
+// the minimum time between effect frames can change at runtime.  The governor
+// stretches it (16ms, 32ms, ... up to RGB_GOVERNOR_MAX_LEVEL doublings)
+//
+//  * straight to the slowest rate while keys are pressed in quick succession,
+//    so animation never competes with a typing burst
+//  * one step at a time when a frame runs over RGB_GOVERNOR_FRAME_BUDGET_US
+//
+// and steps back down once keys have been quiet and frames within budget for
+// RGB_GOVERNOR_RESTORE_MS.
+//
+// Frame cost is measured per chunk: from matrix_scan_user() (call
+// rgb_governor_scan_start()) to the advanced indicator callback for that
+// chunk (call rgb_governor_chunk_done()), summed up until the frame is flushed
+// (call rgb_governor_frame_done() from rgb_matrix_indicators_user()).  The
+// chunk size itself is bounded by RGB_MATRIX_LED_PROCESS_LIMIT in config.h.
+
+#ifndef RGB_GOVERNOR_BASE_INTERVAL
+#    define RGB_GOVERNOR_BASE_INTERVAL 16
+#endif
+#ifndef RGB_GOVERNOR_MAX_LEVEL
+#    define RGB_GOVERNOR_MAX_LEVEL 4
+#endif
+#ifndef RGB_GOVERNOR_FRAME_BUDGET_US
+#    define RGB_GOVERNOR_FRAME_BUDGET_US 2000
+#endif
+#ifndef RGB_GOVERNOR_BURST_KEYS
+#    define RGB_GOVERNOR_BURST_KEYS 3 // presses ...
+#endif
+#ifndef RGB_GOVERNOR_BURST_WINDOW
+#    define RGB_GOVERNOR_BURST_WINDOW 400 // ... within this many ms
+#endif
+#ifndef RGB_GOVERNOR_RESTORE_MS
+#    define RGB_GOVERNOR_RESTORE_MS 1000
+#endif
+
+void rgb_governor_keypress(void);
+void rgb_governor_scan_start(void);
+void rgb_governor_chunk_done(void);
+void rgb_governor_frame_done(void);
+
+// 0 at full rate, each level doubles the frame interval.
+uint8_t rgb_governor_level(void);
+
+void rgb_governor_print(void);
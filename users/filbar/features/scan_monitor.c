@@ -0,0 +1,181 @@
+#include "scan_monitor.h"
+#include "timer_us.h"
+
+#ifdef CONSOLE_ENABLE
+#   include "print.h"
+#endif // CONSOLE_ENABLE
+
+// Histogram covers 1us to 2^SCAN_MONITOR_MAX_LOG2 us, anything longer lands
+// in the last bucket.
+#define SCAN_MONITOR_MAX_LOG2 20
+#define SUB_BUCKETS 4
+#define BUCKET_COUNT ((SCAN_MONITOR_MAX_LOG2 + 1) * SUB_BUCKETS)
+
+static const char *const subsystem_names[SCAN_SUBSYS_COUNT] = {
+    [SCAN_SUBSYS_MATRIX] = "matrix/split",
+    [SCAN_SUBSYS_KEYS]   = "keys",
+    [SCAN_SUBSYS_RGB]    = "rgb",
+    [SCAN_SUBSYS_OLED]   = "oled",
+    [SCAN_SUBSYS_EEPROM] = "eeprom",
+};
+
+static uint32_t histogram[BUCKET_COUNT];
+static uint32_t scan_count;
+static uint32_t max_interval;
+static uint32_t last_scan_at;
+
+static uint32_t window_started_at;
+static uint32_t window_scans;
+static uint32_t scans_per_sec;
+
+static uint8_t  active_subsystem = SCAN_SUBSYS_MATRIX;
+static uint32_t active_since;
+static uint32_t charged[SCAN_SUBSYS_COUNT];
+
+static uint32_t stall_count[SCAN_SUBSYS_COUNT];
+static uint32_t last_stall_us;
+static uint8_t  last_stall_subsystem;
+
+// Bucket n covers [lower(n), lower(n + 1)), where the first SUB_BUCKETS
+// buckets are exact and the rest split each power of two into four.
+static uint8_t bucket_for(uint32_t us) {
+    if (us < SUB_BUCKETS) {
+        return us;
+    }
+
+    uint8_t msb = 0;
+    for (uint32_t v = us; v > 1; v >>= 1) {
+        msb++;
+    }
+    if (msb > SCAN_MONITOR_MAX_LOG2) {
+        return BUCKET_COUNT - 1;
+    }
+
+    const uint8_t sub = (us >> (msb - 2)) & (SUB_BUCKETS - 1);
+    return (msb - 1) * SUB_BUCKETS + sub;
+}
+
+static uint32_t bucket_upper_bound(uint8_t bucket) {
+    if (bucket < SUB_BUCKETS) {
+        return bucket + 1;
+    }
+
+    const uint8_t msb = bucket / SUB_BUCKETS + 1;
+    const uint8_t sub = bucket % SUB_BUCKETS;
+    return ((uint32_t)(SUB_BUCKETS + sub + 1)) << (msb - 2);
+}
+
+static void charge_active(uint32_t now) {
+    charged[active_subsystem] += now - active_since;
+    active_since = now;
+}
+
+void scan_monitor_mark(uint8_t subsystem) {
+    if (subsystem >= SCAN_SUBSYS_COUNT) {
+        return;
+    }
+    charge_active(timer_read_us());
+    active_subsystem = subsystem;
+}
+
+static void record_stall(uint32_t interval) {
+    uint8_t worst = SCAN_SUBSYS_MATRIX;
+    for (uint8_t subsystem = 1; subsystem < SCAN_SUBSYS_COUNT; subsystem++) {
+        if (charged[subsystem] > charged[worst]) {
+            worst = subsystem;
+        }
+    }
+
+    stall_count[worst]++;
+    last_stall_us        = interval;
+    last_stall_subsystem = worst;
+}
+
+void scan_monitor_task(void) {
+    const uint32_t now = timer_read_us();
+
+    if (last_scan_at != 0) {
+        const uint32_t interval = now - last_scan_at;
+
+        charge_active(now);
+        if (interval > SCAN_MONITOR_STALL_US) {
+            record_stall(interval);
+        }
+
+        histogram[bucket_for(interval)]++;
+        scan_count++;
+        if (interval > max_interval) {
+            max_interval = interval;
+        }
+    }
+
+    // The next scan starts with the matrix, split transaction included
+    memset(charged, 0, sizeof(charged));
+    active_subsystem = SCAN_SUBSYS_MATRIX;
+    active_since     = now;
+    last_scan_at     = now;
+
+    window_scans++;
+    if (now - window_started_at >= 1000000) {
+        scans_per_sec     = window_scans;
+        window_scans      = 0;
+        window_started_at = now;
+    }
+}
+
+uint32_t scan_monitor_scans_per_sec(void) {
+    return scans_per_sec;
+}
+
+uint32_t scan_monitor_percentile(uint8_t percent) {
+    if (scan_count == 0) {
+        return 0;
+    }
+
+    // Rank of the sample we are after, rounded up so p100 is the last one
+    const uint32_t rank = (uint32_t)(((uint64_t)scan_count * percent + 99) / 100);
+
+    uint32_t seen = 0;
+    for (uint8_t bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+        seen += histogram[bucket];
+        if (seen >= rank && seen > 0) {
+            return MIN(bucket_upper_bound(bucket), max_interval);
+        }
+    }
+    return max_interval;
+}
+
+uint32_t scan_monitor_max_us(void) {
+    return max_interval;
+}
+
+void scan_monitor_reset(void) {
+    memset(histogram, 0, sizeof(histogram));
+    memset(stall_count, 0, sizeof(stall_count));
+    scan_count    = 0;
+    max_interval  = 0;
+    last_stall_us = 0;
+}
+
+void scan_monitor_print(void) {
+#ifdef CONSOLE_ENABLE
+    uprintf("SCAN: %lu scans/s, p50 %luus, p99 %luus, max %luus over %lu scans\n",
+        (unsigned long)scan_monitor_scans_per_sec(),
+        (unsigned long)scan_monitor_percentile(50),
+        (unsigned long)scan_monitor_percentile(99),
+        (unsigned long)max_interval,
+        (unsigned long)scan_count);
+
+    for (uint8_t subsystem = 0; subsystem < SCAN_SUBSYS_COUNT; subsystem++) {
+        if (stall_count[subsystem]) {
+            uprintf("SCAN: stalls >%luus in %-12s %lu\n",
+                (unsigned long)SCAN_MONITOR_STALL_US,
+                subsystem_names[subsystem],
+                (unsigned long)stall_count[subsystem]);
+        }
+    }
+    if (last_stall_us) {
+        uprintf("SCAN: last stall %luus in %s\n", (unsigned long)last_stall_us, subsystem_names[last_stall_subsystem]);
+    }
+#endif // CONSOLE_ENABLE
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Matrix scan-rate and jitter monitor.
+//
+// Call scan_monitor_task() from housekeeping_task_user(), which runs once at
+// the end of every main loop iteration, and the scan-to-scan interval is
+// recorded in a log-linear histogram (four sub-buckets per power of two, so
+// percentiles are within ~25%).
+//
+// To attribute stalls, the hooks call scan_monitor_mark() as work moves between
+// subsystems.  The time until the next mark is charged to that subsystem and,
+// when a scan runs over SCAN_MONITOR_STALL_US, the subsystem with the largest
+// share of that scan is blamed for it.  The matrix segment starts at the end of
+// the previous scan and includes the split transaction on the master half.
+//
+// Enable with `SCAN_MONITOR_ENABLE = yes` in rules.mk.
+
+enum scan_subsystems {
+    SCAN_SUBSYS_MATRIX = 0, // matrix scan, debounce and split transport
+    SCAN_SUBSYS_KEYS,       // key processing and RGB effect rendering
+    SCAN_SUBSYS_RGB,        // RGB indicators and LED flush
+    SCAN_SUBSYS_OLED,       // OLED rendering and transfer
+    SCAN_SUBSYS_EEPROM,     // keys that persist settings
+    SCAN_SUBSYS_COUNT
+};
+
+#ifndef SCAN_MONITOR_STALL_US
+#    define SCAN_MONITOR_STALL_US 5000
+#endif
+
+#ifdef SCAN_MONITOR_ENABLE
+
+void scan_monitor_task(void);
+void scan_monitor_mark(uint8_t subsystem);
+
+// Scans completed during the last full second.
+uint32_t scan_monitor_scans_per_sec(void);
+
+// Upper bound of the histogram bucket holding the given percentile, in us.
+uint32_t scan_monitor_percentile(uint8_t percent);
+
+// Longest scan seen since the last reset, in us.
+uint32_t scan_monitor_max_us(void);
+
+void scan_monitor_reset(void);
+void scan_monitor_print(void);
+
+#else
+
+static inline void scan_monitor_task(void) {}
+static inline void scan_monitor_mark(uint8_t subsystem) {}
+static inline void scan_monitor_reset(void) {}
+static inline void scan_monitor_print(void) {}
+
+#endif // SCAN_MONITOR_ENABLE
@@ -0,0 +1,28 @@
+#include "sparse_keymap.h"
+#include "layer_tables.h"
+
+uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key) {
+    // QMK's out-of-range answer, so lookups fall through to lower layers
+    if (layer >= LAYER_TABLE_COUNT || key.row >= MATRIX_ROWS || key.col >= MATRIX_COLS) {
+        return KC_TRNS;
+    }
+
+    const uint8_t slot = layer_table_slots[key.row][key.col];
+    if (slot == 0) {
+        return KC_NO;
+    }
+
+    const layer_sparse_t *sparse = &layer_sparse[layer];
+    const uint8_t         index  = slot - 1;
+    const uint8_t         word   = index / 32;
+    const uint32_t        bit    = (uint32_t)1 << (index % 32);
+    const uint32_t        bits   = pgm_read_dword(&sparse->present[word]);
+
+    if (!(bits & bit)) {
+        return pgm_read_word(&sparse->fill);
+    }
+
+    // The stored keys before this one in the word, then the word's own offset
+    const uint16_t offset = pgm_read_word(&sparse->offset[word]) + __builtin_popcount(bits & (bit - 1));
+    return pgm_read_word(&layer_sparse_keycodes[offset]);
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Sparse keymap lookup.
+//
+// Most of a layer is one keycode: KC_TRNS on the alpha overlays, KC_NO on the
+// symbol, navigation and config layers.  tools/gen_layers.py stores each
+// layer as that fill keycode plus the keys that differ from it, packed in
+// layout order, with a presence bit per layout key (layer_sparse in the
+// keymap's keymap.c, see layer_tables.h).
+//
+// sparse_keymap.c replaces QMK's weak keymap_key_to_keycode() with a lookup
+// into those tables: the key's layout position from layer_table_slots, its
+// presence bit, and for a stored key a popcount of the bits below it in the
+// same word to find it in the packed array.  That is constant time per
+// layer, and keymaps[] is no longer read at run time; it stays in keymap.c
+// because QMK's keymap introspection still wants it.
+
+uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key);
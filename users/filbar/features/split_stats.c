@@ -0,0 +1,268 @@
+#include "split_stats.h"
+#include "serial.h"
+#include "timer_us.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef CONSOLE_ENABLE
+#   include "print.h"
+#endif // CONSOLE_ENABLE
+
+#ifndef RPC_M2S_BUFFER_SIZE
+#    define RPC_M2S_BUFFER_SIZE 32
+#endif
+#ifndef RPC_S2M_BUFFER_SIZE
+#    define RPC_S2M_BUFFER_SIZE 32
+#endif
+#define BENCH_MAX_SIZE MIN(RPC_M2S_BUFFER_SIZE, RPC_S2M_BUFFER_SIZE)
+
+extern split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS];
+
+static split_stats_t stats[NUM_TOTAL_TRANSACTIONS];
+static int8_t        last_failed = -1;
+
+static const uint8_t        bench_sizes[] = {1, 4, 8, 16, BENCH_MAX_SIZE};
+static split_bench_result_t bench_results[ARRAY_SIZE(bench_sizes)];
+
+static bool     bench_running = false;
+static uint8_t  bench_size_index;
+static uint32_t bench_started;
+static uint32_t bench_count;
+static uint32_t bench_failures;
+static uint16_t bench_max;
+static uint8_t  bench_seq;
+static uint16_t bench_samples[SPLIT_STATS_BENCH_SAMPLES];
+
+// log2 bucket for a duration: 0 for 0us, k for [2^(k-1), 2^k)
+static uint8_t histogram_bucket(uint32_t elapsed) {
+    uint8_t bucket = 0;
+    while (elapsed) {
+        elapsed >>= 1;
+        bucket++;
+    }
+    return MIN(bucket, SPLIT_STATS_HISTOGRAM_BUCKETS - 1);
+}
+
+static void _count(uint8_t id, bool ok, uint32_t elapsed, uint32_t bytes) {
+    split_stats_t *s = &stats[id];
+    s->attempts++;
+    if (last_failed == id) {
+        s->retries++;
+    }
+    if (ok) {
+        s->bytes += bytes;
+        last_failed = -1;
+    } else {
+        s->failures++;
+        last_failed = id;
+    }
+
+    s->total_us += elapsed;
+    if (elapsed > s->max_us) {
+        s->max_us = elapsed;
+    }
+    uint16_t *bucket = &s->histogram[histogram_bucket(elapsed)];
+    if (*bucket < UINT16_MAX) {
+        (*bucket)++;
+    }
+}
+
+// Set while a user RPC is in flight.  QMK runs it as the shared
+// PUT_RPC_INFO, PUT_RPC_REQUEST, EXECUTE_RPC and GET_RPC_RESPONSE
+// transactions, which are counted under the user id instead.
+static bool in_rpc = false;
+
+bool __real_soft_serial_transaction(int sstd_index);
+
+bool __wrap_soft_serial_transaction(int sstd_index) {
+    const uint32_t started = timer_read_us();
+    const bool     ok      = __real_soft_serial_transaction(sstd_index);
+    const uint32_t elapsed = timer_elapsed_us(started);
+
+    if (in_rpc || sstd_index < 0 || sstd_index >= NUM_TOTAL_TRANSACTIONS) {
+        return ok;
+    }
+
+    const split_transaction_desc_t *desc = &split_transaction_table[sstd_index];
+    _count(sstd_index, ok, elapsed, desc->initiator2target_buffer_size + desc->target2initiator_buffer_size);
+    return ok;
+}
+
+bool __real_transaction_rpc_exec(int8_t transaction_id, uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
+
+bool __wrap_transaction_rpc_exec(int8_t transaction_id, uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    if (in_rpc || transaction_id < 0 || transaction_id >= NUM_TOTAL_TRANSACTIONS) {
+        return __real_transaction_rpc_exec(transaction_id, initiator2target_buffer_size, initiator2target_buffer, target2initiator_buffer_size, target2initiator_buffer);
+    }
+
+    const uint32_t started = timer_read_us();
+    in_rpc                 = true;
+    const bool ok          = __real_transaction_rpc_exec(transaction_id, initiator2target_buffer_size, initiator2target_buffer, target2initiator_buffer_size, target2initiator_buffer);
+    in_rpc                 = false;
+
+    // Payload bytes, the RPC's own framing is not counted
+    _count(transaction_id, ok, timer_elapsed_us(started), initiator2target_buffer_size + target2initiator_buffer_size);
+    return ok;
+}
+
+// transaction_rpc_send() calls transaction_rpc_exec() inside transactions.c,
+// where --wrap does not reach, so it is wrapped on its own
+bool __real_transaction_rpc_send(int8_t transaction_id, uint8_t initiator2target_buffer_size, const void *initiator2target_buffer);
+
+bool __wrap_transaction_rpc_send(int8_t transaction_id, uint8_t initiator2target_buffer_size, const void *initiator2target_buffer) {
+    return __wrap_transaction_rpc_exec(transaction_id, initiator2target_buffer_size, initiator2target_buffer, 0, NULL);
+}
+
+// Runs on the slave, sends the payload straight back
+static void _bench_echo(uint8_t in_buflen, const void *in_data, uint8_t out_buflen, void *out_data) {
+    memcpy(out_data, in_data, MIN(in_buflen, out_buflen));
+}
+
+void split_stats_init(void) {
+    transaction_register_rpc(USER_LINK_BENCH, _bench_echo);
+}
+
+static void _bench_begin_size(void) {
+    bench_started  = timer_read32();
+    bench_count    = 0;
+    bench_failures = 0;
+    bench_max      = 0;
+}
+
+static int _compare_u16(const void *a, const void *b) {
+    return (int)*(const uint16_t *)a - (int)*(const uint16_t *)b;
+}
+
+static void _bench_end_size(void) {
+    const uint8_t  size    = bench_sizes[bench_size_index];
+    const uint32_t elapsed = MAX(timer_elapsed32(bench_started), 1);
+    const uint32_t ok      = bench_count - bench_failures;
+
+    // Percentiles over the most recent samples
+    const uint16_t kept = MIN(bench_count, SPLIT_STATS_BENCH_SAMPLES);
+    qsort(bench_samples, kept, sizeof(bench_samples[0]), _compare_u16);
+
+    bench_results[bench_size_index] = (split_bench_result_t){
+        .size          = size,
+        .count         = bench_count,
+        .failures      = bench_failures,
+        .bytes_per_sec = (uint32_t)((uint64_t)ok * size * 2 * 1000 / elapsed),
+        .p50_us        = kept ? bench_samples[kept / 2] : 0,
+        .p99_us        = kept ? bench_samples[(kept * 99) / 100] : 0,
+        .max_us        = bench_max,
+    };
+}
+
+void split_stats_bench_start(void) {
+    if (!is_keyboard_master()) {
+        return;
+    }
+
+    memset(bench_results, 0, sizeof(bench_results));
+    bench_size_index = 0;
+    bench_running    = true;
+    _bench_begin_size();
+}
+
+bool split_stats_bench_running(void) {
+    return bench_running;
+}
+
+void split_stats_task(void) {
+    if (!bench_running) {
+        return;
+    }
+    if (!is_transport_connected()) {
+        bench_running = false;
+        return;
+    }
+
+    const uint8_t size = bench_sizes[bench_size_index];
+    uint8_t       payload[BENCH_MAX_SIZE];
+    uint8_t       reply[BENCH_MAX_SIZE];
+
+    const uint16_t slice = timer_read();
+    while (timer_elapsed(slice) < SPLIT_STATS_BENCH_SLICE_MS) {
+        // A different first byte each time, so a stale reply does not pass
+        memset(payload, 0xA5, size);
+        payload[0] = bench_seq++;
+
+        const uint32_t started = timer_read_us();
+        const bool     ok      = transaction_rpc_exec(USER_LINK_BENCH, size, payload, size, reply) && memcmp(payload, reply, size) == 0;
+        const uint16_t elapsed = MIN(timer_elapsed_us(started), UINT16_MAX);
+
+        bench_samples[bench_count % SPLIT_STATS_BENCH_SAMPLES] = elapsed;
+        bench_max                                              = MAX(bench_max, elapsed);
+        bench_count++;
+        if (!ok) {
+            bench_failures++;
+        }
+    }
+
+    if (timer_elapsed32(bench_started) < SPLIT_STATS_BENCH_MS) {
+        return;
+    }
+
+    _bench_end_size();
+    if (++bench_size_index < ARRAY_SIZE(bench_sizes)) {
+        _bench_begin_size();
+    } else {
+        bench_running = false;
+        split_stats_print();
+    }
+}
+
+const split_stats_t *split_stats_get(uint8_t transaction) {
+    return transaction < NUM_TOTAL_TRANSACTIONS ? &stats[transaction] : NULL;
+}
+
+void split_stats_reset(void) {
+    memset(stats, 0, sizeof(stats));
+    last_failed = -1;
+}
+
+void split_stats_print(void) {
+#ifdef CONSOLE_ENABLE
+    uprintf("LINK: %4s %8s %8s %6s %6s %10s %6s %6s\n", "id", "attempts", "ok", "fail", "retry", "bytes", "avg", "max");
+    for (uint8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; id++) {
+        const split_stats_t *s = &stats[id];
+        if (s->attempts == 0) {
+            continue;
+        }
+
+        uprintf("LINK: %4u %8lu %8lu %6lu %6lu %10lu %6lu %6lu\n",
+            id,
+            (unsigned long)s->attempts,
+            (unsigned long)(s->attempts - s->failures),
+            (unsigned long)s->failures,
+            (unsigned long)s->retries,
+            (unsigned long)s->bytes,
+            (unsigned long)(s->total_us / s->attempts),
+            (unsigned long)s->max_us);
+
+        // Histogram, one `<limit:count` pair per non-empty bucket
+        uprintf("LINK: %4s", "");
+        for (uint8_t bucket = 0; bucket < SPLIT_STATS_HISTOGRAM_BUCKETS; bucket++) {
+            if (s->histogram[bucket]) {
+                uprintf(" <%lu:%u", (unsigned long)1 << bucket, s->histogram[bucket]);
+            }
+        }
+        uprintf("\n");
+    }
+
+    for (uint8_t i = 0; i < ARRAY_SIZE(bench_results); i++) {
+        const split_bench_result_t *r = &bench_results[i];
+        if (r->count == 0) {
+            continue;
+        }
+        uprintf("LINK: bench %2u bytes: %6lu rpc %4lu fail %7lu B/s p50 %5u p99 %5u max %5u us\n",
+            r->size,
+            (unsigned long)r->count,
+            (unsigned long)r->failures,
+            (unsigned long)r->bytes_per_sec,
+            r->p50_us,
+            r->p99_us,
+            r->max_us);
+    }
+#endif // CONSOLE_ENABLE
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+#include "transactions.h"
+
+// Split link health counters and throughput benchmark.
+//
+// Every split transaction the master runs goes through
+// soft_serial_transaction() in the serial driver; rules.mk links with --wrap
+// for it, so each one is counted per transaction id (the order of enum serial_transaction_id in
+// QMK's transactions.h, user RPCs at the end): attempts, failures, retries
+// (attempts straight after a failure of the same id), bytes moved according
+// to the transaction table and a log2 histogram of the round trip in us.
+//
+// User RPCs never reach the driver under their own id: QMK sends each one as
+// the shared PUT_RPC_INFO, PUT_RPC_REQUEST, EXECUTE_RPC and GET_RPC_RESPONSE
+// transactions.  transaction_rpc_exec() and transaction_rpc_send() are
+// wrapped too, and count the whole exchange under the user id instead, with
+// the payload sizes as the bytes.  The shared RPC rows stay empty.
+//
+// split_stats_bench_start() turns on the benchmark: the master echoes
+// payloads of increasing size off the slave over the USER_LINK_BENCH RPC for
+// SPLIT_STATS_BENCH_MS per size, in slices of SPLIT_STATS_BENCH_SLICE_MS per
+// loop so the keyboard stays usable, and then prints the payload bytes/sec
+// and latency percentiles for each size.
+//
+// Enable with `SPLIT_STATS_ENABLE = yes` in rules.mk, which also adds
+// USER_LINK_BENCH to SPLIT_TRANSACTION_IDS_USER.  --wrap does not work on
+// symbols that go through LTO, so users/filbar/rules.mk sets LTO_ENABLE = no
+// with it, overriding boards that turn LTO on in their info.json.
+
+#ifndef SPLIT_STATS_HISTOGRAM_BUCKETS
+#    define SPLIT_STATS_HISTOGRAM_BUCKETS 14
+#endif
+#ifndef SPLIT_STATS_BENCH_MS
+#    define SPLIT_STATS_BENCH_MS 2000
+#endif
+#ifndef SPLIT_STATS_BENCH_SLICE_MS
+#    define SPLIT_STATS_BENCH_SLICE_MS 10
+#endif
+#ifndef SPLIT_STATS_BENCH_SAMPLES
+#    define SPLIT_STATS_BENCH_SAMPLES 256 // latencies kept per size
+#endif
+
+typedef struct {
+    uint32_t attempts;
+    uint32_t failures;
+    uint32_t retries;
+    uint32_t bytes;
+    uint32_t total_us;
+    uint32_t max_us;
+    uint16_t histogram[SPLIT_STATS_HISTOGRAM_BUCKETS];
+} split_stats_t;
+
+typedef struct {
+    uint8_t  size;
+    uint32_t count;
+    uint32_t failures;
+    uint32_t bytes_per_sec;
+    uint16_t p50_us;
+    uint16_t p99_us;
+    uint16_t max_us;
+} split_bench_result_t;
+
+#ifdef SPLIT_STATS_ENABLE
+
+void split_stats_init(void);
+void split_stats_task(void);
+
+void split_stats_bench_start(void);
+bool split_stats_bench_running(void);
+
+// Returns the counters for a transaction id, or NULL for an unknown one.
+const split_stats_t *split_stats_get(uint8_t transaction);
+
+void split_stats_reset(void);
+void split_stats_print(void);
+
+#else
+
+static inline void split_stats_init(void) {}
+static inline void split_stats_task(void) {}
+static inline void split_stats_bench_start(void) {}
+static inline void split_stats_reset(void) {}
+static inline void split_stats_print(void) {}
+
+#endif // SPLIT_STATS_ENABLE
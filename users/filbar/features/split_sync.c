@@ -0,0 +1,111 @@
+#include "split_sync.h"
+#include "transactions.h"
+#include "idle.h"
+
+#if defined(PROTOCOL_CHIBIOS)
+#    include <ch.h>
+#    define LOCK() chSysLock()
+#    define UNLOCK() chSysUnlock()
+#else
+#    define LOCK()
+#    define UNLOCK()
+#endif
+
+#define HEADER_FLAGS (1 << 0)
+
+static split_sync_state_t state;
+static bool               state_valid = false;
+static uint16_t           last_sent;
+
+// Slave only: what the master last sent, written by the transport thread
+static split_sync_state_t received;
+static volatile bool      received_pending = false;
+
+static uint8_t _pack_flags(const split_sync_state_t *s) {
+    return (s->default_layer & 0x07) | ((s->idle_tier & 0x07) << 3) | (s->caps_word << 6);
+}
+
+static void _unpack_flags(split_sync_state_t *s, uint8_t flags) {
+    s->default_layer = flags & 0x07;
+    s->idle_tier     = (flags >> 3) & 0x07;
+    s->caps_word     = (flags >> 6) & 1;
+}
+
+__attribute__((weak)) void split_sync_update_user(const split_sync_state_t *s) {}
+
+static void _apply(const split_sync_state_t *s) {
+    if (get_highest_layer(default_layer_state) != s->default_layer) {
+        default_layer_set((layer_state_t)1 << s->default_layer);
+    }
+    idle_set_tier(s->idle_tier);
+
+    split_sync_update_user(s);
+}
+
+// Runs in the split transport's thread, not the main loop, so it only
+// decodes the packet and leaves the rest to split_sync_task()
+static void _receive(uint8_t in_buflen, const void *in_data, uint8_t out_buflen, void *out_data) {
+    const uint8_t *packet = in_data;
+    if (in_buflen < 1 || (packet[0] >> 5) != SPLIT_SYNC_VERSION) {
+        return;
+    }
+
+    if (packet[0] & HEADER_FLAGS) {
+        if (in_buflen < 2) {
+            return;
+        }
+        _unpack_flags(&received, packet[1]);
+    }
+
+    received_pending = true;
+}
+
+void split_sync_init(void) {
+    transaction_register_rpc(USER_SYNC_STATE, _receive);
+}
+
+void split_sync_task(const split_sync_state_t *local) {
+    if (!is_keyboard_master()) {
+        if (received_pending) {
+            // Keep the transport thread out while the copy is taken
+            LOCK();
+            state            = received;
+            received_pending = false;
+            UNLOCK();
+
+            state_valid = true;
+            _apply(&state);
+        }
+        return;
+    }
+    if (!is_transport_connected()) {
+        return;
+    }
+
+    const bool heartbeat = !state_valid || timer_elapsed(last_sent) >= SPLIT_SYNC_HEARTBEAT_MS;
+
+    uint8_t packet[2];
+    uint8_t length = 1;
+    packet[0]      = SPLIT_SYNC_VERSION << 5;
+
+    const uint8_t flags = _pack_flags(local);
+    if (heartbeat || flags != _pack_flags(&state)) {
+        packet[0] |= HEADER_FLAGS;
+        packet[length++] = flags;
+    }
+
+    if (length == 1) {
+        return;
+    }
+
+    // Keep the old state on failure so the change goes out again next loop
+    if (transaction_rpc_send(USER_SYNC_STATE, length, packet)) {
+        state       = *local;
+        state_valid = true;
+        last_sent   = timer_read();
+    }
+}
+
+const split_sync_state_t *split_sync_get(void) {
+    return &state;
+}
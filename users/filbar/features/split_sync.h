@@ -0,0 +1,49 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Userspace state sync between the halves.
+//
+// QMK already syncs the layer state (SPLIT_LAYER_STATE_ENABLE, locked layers
+// included), but not the bits of state the keymap keeps itself.  The master hands split_sync_task() its current state every
+// loop; when something changed it is sent to the slave over the
+// USER_SYNC_STATE split transaction as a small bit-packed delta:
+//
+//     byte 0   version (bits 7-5), flags follow (bit 0)
+//     [byte]   default layer (bits 2-0), idle tier (bits 5-3), caps word
+//              (bit 6)
+//
+// so a change costs two bytes on the link and nothing is sent while
+// the state stands still, apart from a full copy every
+// SPLIT_SYNC_HEARTBEAT_MS in case the slave missed something (or restarted).
+//
+// The RPC callback runs in the split transport's thread on the slave, so it
+// only stores what arrived.  The slave's own split_sync_task() then applies
+// the default layer and idle tier from the main loop and calls
+// split_sync_update_user() with the new state, so the keymap can render from
+// it.  Call split_sync_task() on both halves; split_sync_get() returns the
+// master's state on either half.
+//
+// Needs USER_SYNC_STATE in SPLIT_TRANSACTION_IDS_USER (config.h).
+
+#ifndef SPLIT_SYNC_HEARTBEAT_MS
+#    define SPLIT_SYNC_HEARTBEAT_MS 1000
+#endif
+
+// Bump whenever the packet layout changes, both halves have to agree
+#define SPLIT_SYNC_VERSION 2
+
+typedef struct {
+    uint8_t default_layer;
+    uint8_t idle_tier;
+    bool    caps_word;
+} split_sync_state_t;
+
+void split_sync_init(void);
+// Master: sends local when it changed.  Slave: applies what was received.
+void split_sync_task(const split_sync_state_t *local);
+
+const split_sync_state_t *split_sync_get(void);
+
+// Runs on the slave after every change received from the master.
+void split_sync_update_user(const split_sync_state_t *state);
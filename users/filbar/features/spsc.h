@@ -0,0 +1,55 @@
+#pragma once
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// Lock-free single-producer/single-consumer ring buffer.
+//
+//     SPSC_QUEUE(event_queue, uint32_t, 32)
+//
+// defines `event_queue_t` and `event_queue_push(q, &item)` /
+// `event_queue_pop(q, &item)`, which return false when the queue is full or
+// empty.  One side only ever pushes and the other only pops; head is written
+// by the producer alone and tail by the consumer alone, so all that is needed
+// is a release store after touching an item and an acquire load before, no
+// read-modify-write.  That matters on the RP2040, whose Cortex-M0+ cores have
+// no exclusive access instructions.  The RP2040 SRAM has no cache in front of
+// it, so the barriers are all either core needs to see the other's writes.
+//
+// Capacity has to be a power of two.  Nothing in here depends on QMK, so it
+// also works with two host threads standing in for the cores.
+//
+// The functions are forced inline, so they end up in RAM along with whatever
+// core 1 code calls them (see core1.h).
+
+#define SPSC_QUEUE(name, type, capacity)                                                           \
+    _Static_assert(((capacity) & ((capacity) - 1)) == 0, "capacity must be a power of two");      \
+                                                                                                   \
+    typedef struct {                                                                               \
+        _Atomic uint32_t head;                                                                     \
+        _Atomic uint32_t tail;                                                                     \
+        type             items[capacity];                                                          \
+    } name##_t;                                                                                    \
+                                                                                                   \
+    static inline __attribute__((always_inline)) bool name##_push(name##_t *q, const type *item) { \
+        const uint32_t head = atomic_load_explicit(&q->head, memory_order_relaxed);                \
+        const uint32_t tail = atomic_load_explicit(&q->tail, memory_order_acquire);                \
+        if (head - tail == (capacity)) {                                                           \
+            return false;                                                                          \
+        }                                                                                          \
+        q->items[head & ((capacity) - 1)] = *item;                                                 \
+        atomic_store_explicit(&q->head, head + 1, memory_order_release);                           \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    static inline __attribute__((always_inline)) bool name##_pop(name##_t *q, type *item) {        \
+        const uint32_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);                \
+        const uint32_t head = atomic_load_explicit(&q->head, memory_order_acquire);                \
+        if (head == tail) {                                                                        \
+            return false;                                                                          \
+        }                                                                                          \
+        *item = q->items[tail & ((capacity) - 1)];                                                 \
+        atomic_store_explicit(&q->tail, tail + 1, memory_order_release);                           \
+        return true;                                                                               \
+    }
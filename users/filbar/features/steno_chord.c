@@ -0,0 +1,115 @@
+#include "steno_chord.h"
+
+#define KEY_COUNT (STN__MAX - STN__MIN + 1)
+#define GEMINI_BYTES 6
+#define BOLT_BYTES 4
+
+// TX Bolt groups the keys four ways, the group in the top two bits of each
+// byte.  The number bar is all one key, the function keys are not sent.
+#define BOLT(group, bit) ((group) << 6 | 1 << (bit))
+#define BOLT_NUM BOLT(3, 4)
+#define BOLT_STAR BOLT(1, 3)
+#define BOLT_NONE 0
+
+static const uint8_t bolt_keys[KEY_COUNT] PROGMEM = {
+    // Fn, #1 to #6
+    BOLT_NONE, BOLT_NUM, BOLT_NUM, BOLT_NUM, BOLT_NUM, BOLT_NUM, BOLT_NUM,
+    // S1- S2- T- K- P- W- H-
+    BOLT(0, 0), BOLT(0, 0), BOLT(0, 1), BOLT(0, 2), BOLT(0, 3), BOLT(0, 4), BOLT(0, 5),
+    // R- A- O- *1 *2 res1 res2
+    BOLT(1, 0), BOLT(1, 1), BOLT(1, 2), BOLT_STAR, BOLT_STAR, BOLT_NONE, BOLT_NONE,
+    // pwr *3 *4 -E -U -F -R
+    BOLT_NONE, BOLT_STAR, BOLT_STAR, BOLT(1, 4), BOLT(1, 5), BOLT(2, 0), BOLT(2, 1),
+    // -P -B -L -G -T -S -D
+    BOLT(2, 2), BOLT(2, 3), BOLT(2, 4), BOLT(2, 5), BOLT(3, 0), BOLT(3, 1), BOLT(3, 2),
+    // #7 to #C, -Z
+    BOLT_NUM, BOLT_NUM, BOLT_NUM, BOLT_NUM, BOLT_NUM, BOLT_NUM, BOLT(3, 3),
+};
+
+static bool bolt;
+static bool first_up;
+
+// Keys down, and the keys in the chord being built, bit n for STN__MIN + n
+static uint64_t held;
+static uint64_t chord;
+static bool     chord_sent;
+
+// GeminiPR is the keys in STN_* order, seven to a byte below a start bit
+static void send_gemini(void) {
+    uint8_t packet[GEMINI_BYTES] = {0x80};
+    for (uint8_t key = 0; key < KEY_COUNT; key++) {
+        if (chord & ((uint64_t)1 << key)) {
+            packet[key / 7] |= 0x40 >> (key % 7);
+        }
+    }
+    for (uint8_t i = 0; i < GEMINI_BYTES; i++) {
+        virtser_send(packet[i]);
+    }
+}
+
+static void send_bolt(void) {
+    uint8_t packet[BOLT_BYTES] = {0};
+    for (uint8_t key = 0; key < KEY_COUNT; key++) {
+        if (chord & ((uint64_t)1 << key)) {
+            const uint8_t bits = pgm_read_byte(&bolt_keys[key]);
+            packet[bits >> 6] |= bits;
+        }
+    }
+    for (uint8_t i = 0; i < BOLT_BYTES; i++) {
+        if (packet[i]) {
+            virtser_send(packet[i]);
+        }
+    }
+    // Ends the stroke whichever groups it had
+    virtser_send(0);
+}
+
+static void send_chord(void) {
+    if (bolt) {
+        send_bolt();
+    } else {
+        send_gemini();
+    }
+    chord_sent = true;
+}
+
+bool process_steno_chord(uint16_t keycode, keyrecord_t *record, uint16_t first_up_keycode) {
+    if (keycode == QK_STENO_GEMINI || keycode == QK_STENO_BOLT || keycode == first_up_keycode) {
+        if (record->event.pressed) {
+            if (keycode == first_up_keycode) {
+                first_up = !first_up;
+            } else {
+                bolt = keycode == QK_STENO_BOLT;
+            }
+        }
+        return false;
+    }
+    if (keycode < STN__MIN || keycode > STN__MAX) {
+        return true;
+    }
+
+    const uint64_t key = (uint64_t)1 << (keycode - STN__MIN);
+    if (record->event.pressed) {
+        held |= key;
+        chord |= key;
+        chord_sent = false;
+        return false;
+    }
+
+    // Already let go of, nothing to send
+    if (!(held & key)) {
+        return false;
+    }
+    held &= ~key;
+    if (first_up) {
+        // The first key up sends, the rest start the next chord
+        if (!chord_sent) {
+            send_chord();
+        }
+        chord = held;
+    } else if (!held) {
+        send_chord();
+        chord = 0;
+    }
+    return false;
+}
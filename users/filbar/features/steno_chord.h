@@ -0,0 +1,38 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+#include "keymap_steno.h"
+
+// Steno chords sent to Plover over the virtual serial port.
+//
+// The steno layer holds QMK's STN_* keys.  Each key pressed is added to the
+// chord, and the chord goes to the host as one GeminiPR packet (6 bytes,
+// every key) or TX Bolt packet (one byte per group of keys with any down,
+// then a zero) through VIRTSER.  This replaces QMK's own steno support,
+// which only sends once every key is up, and leaves STENO_ENABLE off.
+//
+// Chords are sent when:
+//
+//   - all up (the default), the last key of the chord is released;
+//   - first up, the first key is released.  The keys still down stay in
+//     the chord, so pressing more keys and releasing one sends them again:
+//     hold the shared part of a run of strokes and tap the rest.
+//
+// QK_STENO_GEMINI (the default) and QK_STENO_BOLT pick the protocol, the
+// first-up key toggles the mode.  Neither is kept over a power cycle.
+//
+// Call process_steno_chord() early in process_record_user().
+//
+// Enable with `STENO_CHORD_ENABLE = yes` in rules.mk.
+
+#ifdef STENO_CHORD_ENABLE
+
+bool process_steno_chord(uint16_t keycode, keyrecord_t *record, uint16_t first_up_keycode);
+
+#else
+
+static inline bool process_steno_chord(uint16_t keycode, keyrecord_t *record, uint16_t first_up_keycode) {
+    return true;
+}
+
+#endif // STENO_CHORD_ENABLE
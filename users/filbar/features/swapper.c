@@ -46,9 +46,13 @@ void update_swapper(
             unregister_code(tabish);
             // Don't unregister cmdish until some other key is hit or released.
         }
-    } else if (*active) {
+    } else if (*active && !is_swapper_ignored_key(keycode)) {
         unregister_code(cmdish);
         *active = false;
     }
 }
 
+__attribute__((weak)) bool is_swapper_ignored_key(uint16_t keycode) {
+    return false;
+}
+
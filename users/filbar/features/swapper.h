@@ -18,3 +18,7 @@ void update_swapper(
     uint16_t keycode,
     keyrecord_t *record
 );
+
+// Keys that do not end a swap, so that a one-shot shift can turn it around.
+// None by default, a keymap can define its own.
+bool is_swapper_ignored_key(uint16_t keycode);
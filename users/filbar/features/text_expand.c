@@ -0,0 +1,133 @@
+#include "text_expand.h"
+#include "bulk_send.h"
+
+// Symbol for a word boundary, a to z follow it
+#define BOUNDARY 0
+
+// Typing starts as if after a boundary
+static uint8_t state = 1;
+
+// How the current word was started
+static bool after_boundary = true;
+static bool capital;
+static bool upper;
+
+static bool is_boundary(uint16_t keycode) {
+    switch (keycode) {
+        case KC_SPC:
+        case KC_COMM:
+        case KC_DOT:
+        case KC_SCLN:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static void expand(uint8_t match, uint16_t boundary, bool shifted) {
+    const text_expand_t *word  = &text_expand_words[match - 1];
+    const char          *text  = text_expand_text + pgm_read_word(&word->text);
+    const uint8_t        typed = pgm_read_byte(&word->typed);
+
+    // The boundary is still down, let it go so that it can be typed again
+    unregister_code(boundary);
+
+    // The expansion is typed exactly as stored, whatever is held
+    const uint8_t mods = get_mods();
+    clear_mods();
+    clear_weak_mods();
+    clear_oneshot_mods();
+
+    for (uint8_t i = 0; i <= typed; i++) {
+        bulk_send_key(KC_BSPC, false);
+    }
+    for (bool first = true;; first = false) {
+        char c = pgm_read_byte(text++);
+        if (!c) {
+            break;
+        }
+        if ((upper || (capital && first)) && c >= 'a' && c <= 'z') {
+            c += 'A' - 'a';
+        }
+        bulk_send_char(c);
+    }
+    bulk_send_key(boundary, shifted);
+    bulk_send_flush();
+
+    set_mods(mods);
+}
+
+static void step(uint16_t keycode, bool shifted) {
+    // Shortcuts are not text
+    if (get_mods() & ~MOD_MASK_SHIFT) {
+        state          = 0;
+        after_boundary = false;
+        return;
+    }
+    shifted = shifted || (get_mods() & MOD_MASK_SHIFT);
+
+    uint8_t symbol;
+    if (keycode >= KC_A && keycode <= KC_Z) {
+        symbol = 1 + keycode - KC_A;
+        if (after_boundary) {
+            capital = shifted;
+            upper   = is_caps_word_on();
+        }
+    } else if (is_boundary(keycode)) {
+        symbol = BOUNDARY;
+    } else if (keycode == KC_ENT || keycode == KC_TAB) {
+        // Already acted on by the host, too late to take back: only start over
+        state          = 1;
+        after_boundary = true;
+        return;
+    } else {
+        state          = 0;
+        after_boundary = false;
+        return;
+    }
+
+    state          = pgm_read_byte(&text_expand_next[state][symbol]);
+    after_boundary = symbol == BOUNDARY;
+
+    const uint8_t match = pgm_read_byte(&text_expand_match[state]);
+    if (match) {
+        expand(match, keycode, shifted);
+    }
+}
+
+void post_process_text_expand(uint16_t keycode, keyrecord_t *record) {
+    if (!record->event.pressed) {
+        return;
+    }
+
+    // Held tap-hold keys are mods and layers, tapped ones their tap keycode
+    if (IS_QK_MOD_TAP(keycode) || IS_QK_LAYER_TAP(keycode)) {
+        if (record->tap.count == 0) {
+            return;
+        }
+        keycode = IS_QK_MOD_TAP(keycode) ? QK_MOD_TAP_GET_TAP_KEYCODE(keycode) : QK_LAYER_TAP_GET_TAP_KEYCODE(keycode);
+    }
+
+    bool shifted = false;
+    if (IS_QK_MODS(keycode)) {
+        const uint8_t mods = QK_MODS_GET_MODS(keycode);
+        if (mods & ~(MOD_LSFT | MOD_RSFT)) {
+            state          = 0;
+            after_boundary = false;
+            return;
+        }
+        shifted = true;
+        keycode = QK_MODS_GET_BASIC_KEYCODE(keycode);
+    }
+
+    // Plain modifiers only change how the next key is sent
+    if (IS_MODIFIER_KEYCODE(keycode)) {
+        return;
+    }
+    step(keycode, shifted);
+}
+
+void text_expand_autoshift_press(uint16_t keycode, bool shifted) {
+    // Retro shifted tap-hold keys come with the hold still in the keycode
+    step(IS_RETRO(keycode) ? keycode & 0xFF : keycode, shifted);
+}
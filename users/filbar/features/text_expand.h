@@ -0,0 +1,55 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Abbreviation expander.
+//
+// Follows the keys as they are sent through an Aho-Corasick automaton that
+// tools/gen_layers.py builds from the "expand" list in
+// layouts/filbar/layers.json (text_expand_next and friends in the keymap's
+// keymap.c).  Each abbreviation is matched as a whole word, from one word
+// boundary (space, comma, dot or semicolon) to the next.  The
+// failure links are folded into a full transition table, so every key is a
+// single table read however many abbreviations there are; the only RAM used
+// is the current state and the case the word was started in.
+//
+// When a boundary completes an abbreviation it is backspaced out along with
+// the boundary, and the expansion and boundary are sent in its place.  An
+// abbreviation started with a shifted letter gets a capitalised expansion,
+// one typed in caps word an upper-case one.  Backspace, digits and keys sent
+// with ctrl, alt or gui break the word.  Enter and tab start a new word but
+// never complete one: by the time they are seen the host has sent the line
+// or moved focus, and backspacing would not undo that.
+//
+// Keys are seen once they have gone out, so that auto shift has decided on
+// the shift: call post_process_text_expand() from post_process_record_user()
+// and text_expand_autoshift_press() from autoshift_press_user(), which is
+// where the keys Auto Shift holds back finally go out.
+//
+// Enable with `TEXT_EXPAND_ENABLE = yes` in rules.mk.
+
+// Symbols of the automaton, a word boundary then a to z
+#define TEXT_EXPAND_SYMBOLS 27
+
+typedef struct {
+    uint16_t text;  // offset of the expansion in text_expand_text
+    uint8_t  typed; // letters in the abbreviation
+} text_expand_t;
+
+#ifdef TEXT_EXPAND_ENABLE
+
+// Generated in keymap.c, state 0 is inside a word that cannot match
+extern const uint8_t       text_expand_next[][TEXT_EXPAND_SYMBOLS];
+extern const uint8_t       text_expand_match[];
+extern const text_expand_t text_expand_words[];
+extern const char          text_expand_text[];
+
+void post_process_text_expand(uint16_t keycode, keyrecord_t *record);
+void text_expand_autoshift_press(uint16_t keycode, bool shifted);
+
+#else
+
+static inline void post_process_text_expand(uint16_t keycode, keyrecord_t *record) {}
+static inline void text_expand_autoshift_press(uint16_t keycode, bool shifted) {}
+
+#endif // TEXT_EXPAND_ENABLE
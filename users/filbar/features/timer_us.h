@@ -0,0 +1,25 @@
+#pragma once
+
+#include "quantum.h"
+
+#if defined(MCU_RP)
+#    include "hardware/structs/timer.h"
+#endif
+
+// Free-running microsecond clock used by the instrumentation features.
+//
+// On the RP2040 this is the low word of the 1MHz system timer, which keeps
+// counting regardless of what ChibiOS is doing and wraps every ~71 minutes.
+// Other MCUs fall back to the millisecond timer so the code still builds, the
+// numbers are just a lot coarser.  Always compare readings by subtraction.
+static inline uint32_t timer_read_us(void) {
+#if defined(MCU_RP)
+    return timer_hw->timerawl;
+#else
+    return timer_read32() * 1000;
+#endif
+}
+
+static inline uint32_t timer_elapsed_us(uint32_t last) {
+    return timer_read_us() - last;
+}
@@ -0,0 +1,148 @@
+# Shared userspace for the filbar keymaps, included by QMK after the
+# keymap's own rules.mk.  Keymaps turn the optional features below on by
+# setting the switch to yes in their rules.mk.
+
+SRC += features/layer_lock.c
+SRC += features/swapper.c
+SRC += features/deferred_init.c
+SRC += features/idle.c
+SRC += features/rgb_governor.c
+SRC += features/keymap_cache.c
+SRC += features/split_sync.c
+SRC += features/heatmap.c
+SRC += features/sparse_keymap.c
+SRC += features/bulk_send.c
+SRC += features/oneshot.c
+
+# Legends of the active layer on the OLEDs
+ifeq ($(strip $(OLED_ENABLE)), yes)
+    SRC += features/oled_legend.c
+endif
+
+# Custom effects in rgb_matrix_user.inc
+RGB_MATRIX_CUSTOM_USER = yes
+
+# Time the userspace hooks, dump the results with the STATS key on the
+# config layer.  Needs CONSOLE_ENABLE to see the output.
+PROFILER_ENABLE ?= no
+
+ifeq ($(strip $(PROFILER_ENABLE)), yes)
+    OPT_DEFS += -DPROFILER_ENABLE
+    SRC += features/profiler.c
+endif
+
+# Scan-rate and jitter histogram with stall attribution, also dumped
+# with the STATS key.
+SCAN_MONITOR_ENABLE ?= no
+
+ifeq ($(strip $(SCAN_MONITOR_ENABLE)), yes)
+    OPT_DEFS += -DSCAN_MONITOR_ENABLE
+    SRC += features/scan_monitor.c
+endif
+
+# Latency from matrix change to the HID report carrying the key, per
+# keycode class.  Also dumped with the STATS key.
+KEY_LATENCY_ENABLE ?= no
+
+ifeq ($(strip $(KEY_LATENCY_ENABLE)), yes)
+    OPT_DEFS += -DKEY_LATENCY_ENABLE
+    SRC += features/key_latency.c
+    HOST_HOOK_ENABLE = yes
+endif
+
+# Stack high-water marks and RAM usage, dumped with the STATS key and
+# checked by tools/mem_report.py
+MEM_STATS_ENABLE ?= no
+
+ifeq ($(strip $(MEM_STATS_ENABLE)), yes)
+    OPT_DEFS += -DMEM_STATS_ENABLE
+    SRC += features/mem_stats.c
+endif
+
+# Boot phase timestamps and time-to-first-report after wake or replug,
+# dumped with the STATS key
+BOOT_PROFILE_ENABLE ?= no
+
+ifeq ($(strip $(BOOT_PROFILE_ENABLE)), yes)
+    OPT_DEFS += -DBOOT_PROFILE_ENABLE
+    SRC += features/boot_profile.c
+    HOST_HOOK_ENABLE = yes
+endif
+
+# Per-transaction split link counters, and a link benchmark started with
+# shifted STATS.  Wraps the serial driver with --wrap, which LTO defeats, so
+# this turns LTO off even on boards that build with it (the Aurora Lily58's
+# info.json does).
+SPLIT_STATS_ENABLE ?= no
+
+ifeq ($(strip $(SPLIT_STATS_ENABLE)), yes)
+    LTO_ENABLE = no
+    OPT_DEFS += -DSPLIT_STATS_ENABLE
+    SRC += features/split_stats.c
+    EXTRALDFLAGS += -Wl,--wrap=soft_serial_transaction
+    EXTRALDFLAGS += -Wl,--wrap=transaction_rpc_exec -Wl,--wrap=transaction_rpc_send
+endif
+
+# Render the typing heatmap on the RP2040's second core
+CORE1_ENABLE ?= no
+
+ifeq ($(strip $(CORE1_ENABLE)), yes)
+    OPT_DEFS += -DCORE1_ENABLE
+    SRC += features/core1.c
+endif
+
+# Raw key event trace on the console for tools/latency_model.py
+KEY_TRACE_ENABLE ?= no
+
+ifeq ($(strip $(KEY_TRACE_ENABLE)), yes)
+    OPT_DEFS += -DKEY_TRACE_ENABLE
+    SRC += features/key_trace.c
+endif
+
+# Leader key sequences from layouts/filbar/layers.json, started with LDR
+LEADER_TRIE_ENABLE ?= no
+
+ifeq ($(strip $(LEADER_TRIE_ENABLE)), yes)
+    OPT_DEFS += -DLEADER_TRIE_ENABLE
+    SRC += features/leader_trie.c
+endif
+
+# Combos by key position from layouts/filbar/layers.json
+POSITION_COMBO_ENABLE ?= no
+
+ifeq ($(strip $(POSITION_COMBO_ENABLE)), yes)
+    OPT_DEFS += -DPOSITION_COMBO_ENABLE
+    SRC += features/position_combo.c
+endif
+
+# Abbreviations from layouts/filbar/layers.json expanded as they are typed
+TEXT_EXPAND_ENABLE ?= no
+
+ifeq ($(strip $(TEXT_EXPAND_ENABLE)), yes)
+    OPT_DEFS += -DTEXT_EXPAND_ENABLE
+    SRC += features/text_expand.c
+endif
+
+# Dynamic macros recorded from the outgoing reports, with MREC and MACn
+MACRO_RECORDER_ENABLE ?= no
+
+ifeq ($(strip $(MACRO_RECORDER_ENABLE)), yes)
+    OPT_DEFS += -DMACRO_RECORDER_ENABLE
+    SRC += features/macro_recorder.c
+    HOST_HOOK_ENABLE = yes
+endif
+
+# Steno chords for Plover over the virtual serial port, from the _STENO layer
+STENO_CHORD_ENABLE ?= no
+
+ifeq ($(strip $(STENO_CHORD_ENABLE)), yes)
+    OPT_DEFS += -DSTENO_CHORD_ENABLE
+    SRC += features/steno_chord.c
+    VIRTSER_ENABLE = yes
+endif
+
+# Outgoing report hook shared by the features above, keep this last
+ifeq ($(strip $(HOST_HOOK_ENABLE)), yes)
+    OPT_DEFS += -DHOST_HOOK_ENABLE
+    SRC += features/host_hook.c
+endif